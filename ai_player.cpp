@@ -0,0 +1,120 @@
+#include "ai_player.h"
+
+namespace OthelloEngine {
+
+AIPlayer::AIPlayer(AIDifficulty difficulty, unsigned seed) : level(difficulty), rng(seed) {}
+
+int AIPlayer::chooseMove(const Position& pos, Color side) {
+    last = SearchResult();
+    fromBook = false;
+    MoveList moves(pos.legalMoves(side));
+    if (moves.empty()) return -1;
+    switch (level) {
+    case AIDifficulty::EASY: {
+        MoveList good;
+        for (int sq : moves) if (popCount(pos.flipsFor(side, sq)) > 2) good.push(sq);
+        const MoveList& pick = good.empty() ? moves : good;
+        return pick[std::uniform_int_distribution<int>(0, pick.size - 1)(rng)];
+    }
+    case AIDifficulty::MEDIUM: {
+        int best = -1, bestMove = moves[0];
+        for (int sq : moves) { int f = popCount(pos.flipsFor(side, sq)); if (f > best) { best = f; bestMove = sq; } }
+        return bestMove;
+    }
+    case AIDifficulty::HARD:
+        // a book entry is only trusted if it is legal here (hash collisions, foreign books)
+        if (int bookMove = book ? book->pick(pos, side, rng) : -1;
+            bookMove >= 0 && (pos.legalMoves(side) & squareBit(bookMove))) {
+            stopPondering();
+            last.move = bookMove;
+            fromBook = true;
+            return bookMove;
+        }
+        if (ponder.valid()) {
+            if (pos == ponderPos && side == ponderSide) {
+                // ponder hit: let it use the rest of the budget, counted from when it started
+                if (limits.timeMs > 0) ponder.wait_until(ponderStart + std::chrono::milliseconds(limits.timeMs));
+                else ponder.wait();  // depth-limited: the ponder search is the full search
+                searcher.stop();
+                SearchResult r = ponder.get();
+                searcher.clearStop();
+                if (r.depth > 0 || r.exact) {
+                    ++hits;
+                    last = r;
+                    startPondering(pos, side, last.move);
+                    return last.move;
+                }
+            } else {
+                stopPondering();
+            }
+            ++misses;
+        }
+        last = searcher.search(pos, side, limits);
+        startPondering(pos, side, last.move);
+        return last.move;
+    }
+    return moves[0];
+}
+
+void AIPlayer::startMove(const Position& pos, Color side) {
+    cancelMove();
+    jobSearching = true;
+    job = std::async(std::launch::async, [this, pos, side] { return chooseMove(pos, side); });
+}
+
+int AIPlayer::takeMove() {
+    int move = job.get();
+    std::lock_guard<std::mutex> lock(jobMutex);
+    jobSearching = false;
+    searcher.clearStop();  // a moveNow() that came too late must not stop the next search
+    return move;
+}
+
+void AIPlayer::moveNow() {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    if (jobSearching) searcher.stop();
+}
+
+void AIPlayer::cancelMove() {
+    if (!job.valid()) return;
+    moveNow();
+    job.wait();
+    job = std::future<int>();
+    std::lock_guard<std::mutex> lock(jobMutex);
+    jobSearching = false;
+    searcher.clearStop();
+}
+
+void AIPlayer::stopPondering() {
+    if (!ponder.valid()) return;
+    searcher.stop();
+    ponder.wait();
+    ponder = std::future<SearchResult>();
+    searcher.clearStop();
+}
+
+// `move` was just chosen for `side` in `pos`; ponders our reply to the predicted answer.
+void AIPlayer::startPondering(const Position& pos, Color side, int move) {
+    {
+        // the move is chosen: from here on a late moveNow must not reach the ponder search
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobSearching = false;
+        searcher.clearStop();
+    }
+    if (!ponderEnabled || move < 0 || last.stats.pv.size() < 2) return;
+    Color opp = opponentOf(side);
+    Position next = pos;
+    next.makeMove(side, move);
+    int reply = last.stats.pv[1];
+    if (reply < 0 || !(next.legalMoves(opp) & squareBit(reply))) return;  // a forced pass needs no pondering
+    next.makeMove(opp, reply);
+    if (!next.legalMoves(side)) return;
+    ponderPos = next;
+    ponderSide = side;
+    ponderStart = std::chrono::steady_clock::now();
+    SearchLimits ponderLimits = limits;
+    ponderLimits.timeMs = 0;  // until stopped or maxDepth
+    ponder = std::async(std::launch::async, [this, ponderLimits] { return searcher.search(ponderPos, ponderSide, ponderLimits); });
+}
+
+} // namespace OthelloEngine
@@ -0,0 +1,99 @@
+#ifndef AI_PLAYER_H
+#define AI_PLAYER_H
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <random>
+
+#include "bitboard.h"
+#include "opening_book.h"
+#include "search.h"
+
+namespace OthelloEngine {
+
+// EASY: random move, preferring ones that flip more than two discs. MEDIUM: greedy, most flips.
+// HARD: Searcher with the configured limits.
+enum class AIDifficulty { EASY, MEDIUM, HARD };
+
+// Computer player shared by the console game and reversi_selfplay. Each instance owns its own
+// Searcher (and transposition table), so separate instances can play on separate threads.
+//
+// HARD plays from the opening book, when one is set, until the game leaves it.
+//
+// With pondering on (HARD only), chooseMove returns right after starting a background search of
+// the position after the opponent's predicted reply (second move of the PV). If the opponent then
+// plays it, the next chooseMove takes that search over: it only waits for whatever is left of
+// the time budget, measured from when pondering started, and often answers at once. On any other
+// position the ponder search is stopped and a normal search runs (the TT keeps what it learned).
+class AIPlayer {
+public:
+    explicit AIPlayer(AIDifficulty difficulty = AIDifficulty::MEDIUM, unsigned seed = std::random_device()());
+    ~AIPlayer() { cancelMove(); stopPondering(); }
+    AIPlayer(const AIPlayer&) = delete;
+    AIPlayer& operator=(const AIPlayer&) = delete;
+
+    // Square to play for `side`, or -1 when it has no legal move.
+    int chooseMove(const Position& pos, Color side);
+
+    // Asynchronous chooseMove for front ends that must keep drawing: startMove runs it on a worker
+    // thread, poll moveReady() each frame, then takeMove(). Other members must not be called meanwhile,
+    // except moveNow (stop searching, the best move so far becomes ready shortly) and cancelMove
+    // (stop, wait for the worker and discard the result, e.g. before an undo).
+    void startMove(const Position& pos, Color side);
+    bool thinking() const { return job.valid(); }
+    bool moveReady() const { return job.valid() && job.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+    int takeMove();
+    void moveNow();
+    void cancelMove();
+
+    // Result of the last HARD search (default-constructed for the other levels; only the move for book moves).
+    const SearchResult& lastResult() const { return last; }
+    bool lastFromBook() const { return fromBook; }
+    // The book must outlive the player; nullptr disables it.
+    void setOpeningBook(const OpeningBook* b) { book = b; }
+
+    // Forgets what earlier games taught the searcher (transposition table), e.g. between self-play games.
+    void newGame() { cancelMove(); stopPondering(); searcher.clearHash(); }
+
+    void setPondering(bool on) { if (!on) stopPondering(); ponderEnabled = on; }
+    bool isPondering() const { return ponder.valid(); }
+    // Cancels a running ponder search and waits for it; cheap when none is running.
+    void stopPondering();
+    unsigned ponderHits() const { return hits; }
+    unsigned ponderMisses() const { return misses; }
+
+    AIDifficulty difficulty() const { return level; }
+    void setDifficulty(AIDifficulty d) { cancelMove(); stopPondering(); level = d; }
+    const SearchLimits& searchLimits() const { return limits; }
+    void setSearchLimits(const SearchLimits& l) { cancelMove(); stopPondering(); limits = l; }
+    void setHashSize(size_t megabytes) { cancelMove(); stopPondering(); searcher.setHashSize(megabytes); }
+    void setThreads(int count) { cancelMove(); stopPondering(); searcher.setThreads(count); }
+
+private:
+    void startPondering(const Position& pos, Color side, int move);
+
+    AIDifficulty level;
+    SearchLimits limits;
+    Searcher searcher;
+    SearchResult last;
+    bool fromBook = false;
+    const OpeningBook* book = nullptr;
+    std::mt19937 rng;
+
+    std::future<int> job;  // startMove worker
+    // True from startMove until the worker's own search is over. moveNow and cancelMove only stop the
+    // searcher while it is set, so they never hit the ponder search the worker may start afterwards.
+    std::mutex jobMutex;
+    bool jobSearching = false;
+
+    bool ponderEnabled = false;
+    std::future<SearchResult> ponder;  // valid while a ponder search runs or awaits collection
+    Position ponderPos;                // position being pondered, with ponderSide (us) to move
+    Color ponderSide = BLACK;
+    std::chrono::steady_clock::time_point ponderStart;
+    unsigned hits = 0, misses = 0;
+};
+
+} // namespace OthelloEngine
+
+#endif
@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "bitboard.h"
+#include "cli_args.h"
+#include "game_record.h"
+#include "search.h"
+#include "transposition_table.h"
+
+// Offline game annotation, no SFML dependency.
+// Usage:
+//   reversi_analyze GAMES [--out FILE] [--depth D | --ms T] [--threads N] [--hash MB]
+//                   [--endgame E] [--blunder S] [--cache-discs N] [--offset BYTES] [--resume]
+//       GAMES: one game per line as concatenated squares, e.g. f5d6c3d3c4f4... ("-" reads stdin),
+//              or a game record file (game_record.h), e.g. from reversi_selfplay --record
+// Every move is compared with the engine's choice at a fixed depth (default 8) or time per move;
+// positions with at most --endgame empties (default 16) are solved exactly.
+// Output is one JSON object per game and line, in input order:
+//   {"offset": O, "next": N, "moves": [{"move": "f5", "best": "d3", "score": S, "best_score": B,
+//    "loss": L, "blunder": false}, ...], "margin": M}
+// Scores are engine units from the mover's side (exact endgame results are discs * 1000); loss is
+// best_score - score, and moves losing at least --blunder (default 100) are flagged. "offset" and
+// "next" are byte offsets of the game and of the line (record) after it in GAMES; --offset starts reading
+// at a line boundary, --resume continues after the last complete line already in --out.
+// Games are read and annotated in batches of a few per worker thread, so memory stays bounded
+// whatever the size of the corpus; output is flushed after each batch.
+// Results for positions with at most --cache-discs discs (default 16, 0 disables) are shared by all
+// games through a cache keyed by canonicalHash, so an opening line, its transpositions and its mirror
+// images are searched once per run.
+
+using namespace OthelloEngine;
+
+namespace {
+
+struct Options {
+    SearchLimits limits;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    size_t hashMb = 16;  // per worker thread
+    int blunder = 100;
+    int cacheDiscs = 16;
+    long long offset = 0;
+    bool resume = false;
+    std::string in, out;
+};
+
+const int GAMES_PER_THREAD = 16;  // batch size per worker: bounds memory and the work lost on a crash
+
+struct Game {
+    long long offset, next;
+    std::string moves, result;
+};
+
+// Search results of early positions, shared by all workers. Entries are keyed by canonicalHash and
+// hold the canonical board (mover as black) with moves in its frame. Each one comes from a search of
+// that canonical board from a cleared table, so it does not depend on which game, worker or mirror
+// image reached the position first, and the output stays reproducible.
+class ResultCache {
+public:
+    enum Kind { BEST = 0, AFTER_MOVE = 1 };  // engine's best move / a played move's score (scoreAfterMove)
+    struct Entry {
+        uint64_t own, opp;
+        int move, score;
+    };
+    static const size_t MAX_ENTRIES = size_t(1) << 20;  // about 64 MB; later positions are searched as usual
+
+    bool find(Kind kind, uint64_t key, const Position& canonical, Entry& out) const {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = entries[kind].find(key);
+        if (it == entries[kind].end() || it->second.own != canonical.discs[BLACK] || it->second.opp != canonical.discs[WHITE]) return false;
+        out = it->second;
+        ++hitCount;
+        return true;
+    }
+    void insert(Kind kind, uint64_t key, const Entry& entry) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (entries[BEST].size() + entries[AFTER_MOVE].size() < MAX_ENTRIES) entries[kind].emplace(key, entry);
+    }
+    size_t size() const { std::lock_guard<std::mutex> guard(lock); return entries[BEST].size() + entries[AFTER_MOVE].size(); }
+    unsigned long long hits() const { std::lock_guard<std::mutex> guard(lock); return hitCount; }
+
+private:
+    mutable std::mutex lock;
+    std::unordered_map<uint64_t, Entry> entries[2];
+    mutable unsigned long long hitCount = 0;
+};
+
+// Each worker searches cache misses on its own small table, cleared before every such search.
+const size_t CACHE_SEARCH_HASH_MB = 2;
+
+void annotate(Game& game, Searcher& searcher, Searcher& cacheSearcher, ResultCache& cache, const Options& options) {
+    searcher.clearHash();  // results must not depend on which games the worker annotated before
+    // Score of `p` for `s` under `limits`: the best search (move set) or scoreAfterMove (move = -1).
+    auto score = [&](ResultCache::Kind kind, const Position& p, Color s, const SearchLimits& limits, int& move) {
+        auto run = [&](Searcher& engine, const Position& q, Color qs) {
+            if (kind == ResultCache::AFTER_MOVE) { move = -1; return scoreAfterMove(engine, q, qs, limits); }
+            SearchResult r = engine.search(q, qs, limits);
+            move = r.move;
+            return r.score;
+        };
+        if (popCount(p.occupied()) > options.cacheDiscs) return run(searcher, p, s);
+        int sym;
+        uint64_t key = canonicalHash(p, s, &sym);
+        Position canonical;
+        canonical.discs[BLACK] = transformBoard(p.discs[s], sym);
+        canonical.discs[WHITE] = transformBoard(p.discs[opponentOf(s)], sym);
+        ResultCache::Entry e;
+        if (!cache.find(kind, key, canonical, e)) {
+            cacheSearcher.clearHash();
+            e.own = canonical.discs[BLACK];
+            e.opp = canonical.discs[WHITE];
+            e.score = run(cacheSearcher, canonical, BLACK);
+            e.move = move;
+            cache.insert(kind, key, e);
+        }
+        move = e.move < 0 ? -1 : untransformSquare(e.move, sym);
+        return e.score;
+    };
+    std::ostringstream out;
+    out << "{\"offset\": " << game.offset << ", \"next\": " << game.next;
+    Position pos = Position::initial();
+    Color side = BLACK;
+    const std::string& line = game.moves;
+    size_t i = 0;
+    while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) ++i;
+    out << ", \"moves\": [";
+    for (int ply = 0; i + 1 < line.size() && line[i] != ' ' && line[i] != '\r'; i += 2, ++ply) {
+        if (!pos.legalMoves(side)) side = opponentOf(side);  // pass
+        int sq = parseSquare(line.c_str() + i);
+        if (sq < 0 || !(pos.legalMoves(side) & squareBit(sq))) {
+            out << "], \"error\": \"illegal move " << line.substr(i, 2) << " at ply " << ply + 1 << "\"}";
+            game.result = out.str();
+            return;
+        }
+        int bestMove, unused;
+        int bestScore = score(ResultCache::BEST, pos, side, options.limits, bestMove);
+        int played = bestScore;
+        Position child = pos;
+        child.makeMove(side, sq);
+        if (sq != bestMove) {
+            // the played move, one ply less deep so both scores see the same horizon; the child is
+            // solved exactly if and only if the root was, so the two scores are on the same scale
+            SearchLimits childLimits = options.limits;
+            if (childLimits.timeMs <= 0) childLimits.maxDepth = std::max(1, childLimits.maxDepth - 1);
+            if (childLimits.endgameEmpties >= 0) --childLimits.endgameEmpties;
+            played = score(ResultCache::AFTER_MOVE, child, side, childLimits, unused);
+        }
+        int loss = std::max(0, bestScore - played);
+        out << (ply ? ", " : "") << "{\"move\": \"" << squareName(sq) << "\", \"best\": \"" << squareName(bestMove)
+            << "\", \"score\": " << played << ", \"best_score\": " << bestScore << ", \"loss\": " << loss
+            << ", \"blunder\": " << (loss >= options.blunder ? "true" : "false") << "}";
+        pos = child;
+        side = opponentOf(side);
+    }
+    out << "], \"margin\": " << pos.count(BLACK) - pos.count(WHITE) << "}";
+    game.result = out.str();
+}
+
+// Offset to continue from: "next" of the last complete line of the output file, which is cut back
+// to that line. 0 when the file is missing or empty.
+bool resumeOffset(const std::string& path, long long& offset) {
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec || size == 0) return true;
+    std::ifstream file(path, std::ios::binary);
+    const uintmax_t TAIL = 1 << 16;  // far longer than any output line
+    uintmax_t start = size > TAIL ? size - TAIL : 0;
+    std::string tail(static_cast<size_t>(size - start), '\0');
+    file.seekg(static_cast<std::streamoff>(start));
+    if (!file.read(&tail[0], static_cast<std::streamsize>(tail.size()))) return false;
+    file.close();
+    size_t end = tail.rfind('\n');
+    if (end == std::string::npos) return false;
+    size_t begin = tail.rfind('\n', end ? end - 1 : 0);
+    begin = begin == std::string::npos || begin >= end ? 0 : begin + 1;
+    if (begin == 0 && start > 0) return false;
+    const char* next = std::strstr(tail.c_str() + begin, "\"next\": ");
+    if (!next || next > tail.c_str() + end) return false;
+    offset = std::atoll(next + 8);
+    if (start + end + 1 < size) std::filesystem::resize_file(path, start + end + 1, ec);  // drop a partial line
+    return !ec;
+}
+
+int usage() {
+    std::cerr << "usage: reversi_analyze GAMES [--out FILE] [--depth D | --ms T] [--threads N] [--hash MB]\n"
+                 "                       [--endgame E] [--blunder S] [--cache-discs N] [--offset BYTES] [--resume]\n";
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage();
+    Options options;
+    options.in = argv[1];
+    options.limits.timeMs = 0;
+    options.limits.maxDepth = 8;
+    for (int i = 2; i < argc; ++i) {
+        std::string opt = argv[i];
+        if (opt == "--resume") { options.resume = true; continue; }
+        if (i + 1 >= argc) return usage();
+        std::string val = argv[++i];
+        bool ok = true;
+        if (opt == "--out") options.out = val;
+        else if (opt == "--depth") ok = parseNumber(val, 1, 60, options.limits.maxDepth);
+        else if (opt == "--ms") { ok = parseNumber(val, 1, 3600000, options.limits.timeMs); options.limits.maxDepth = 60; }
+        else if (opt == "--threads") ok = parseNumber(val, 1, 1024, options.threads);
+        else if (opt == "--hash") ok = parseNumber(val, size_t(1), TranspositionTable::MAX_MEGABYTES, options.hashMb);
+        else if (opt == "--endgame") ok = parseNumber(val, -1, 60, options.limits.endgameEmpties);
+        else if (opt == "--blunder") ok = parseNumber(val, 0, 1000000, options.blunder);
+        else if (opt == "--cache-discs") ok = parseNumber(val, 0, 64, options.cacheDiscs);
+        else if (opt == "--offset") ok = parseNumber(val, 0LL, std::numeric_limits<long long>::max(), options.offset);
+        else return usage();
+        if (!ok) { std::cerr << "bad value for " << opt << ": " << val << '\n'; return usage(); }
+    }
+    if (options.threads < 1) options.threads = 1;
+    if (options.resume) {
+        if (options.out.empty()) { std::cerr << "--resume needs --out\n"; return 1; }
+        if (!resumeOffset(options.out, options.offset)) { std::cerr << "cannot resume from " << options.out << '\n'; return 1; }
+    }
+
+    GameRecordReader records;
+    std::ifstream file;
+    if (options.in != "-" && records.open(options.in)) {
+        if (options.offset) records.seek(static_cast<size_t>(options.offset));
+    } else if (options.in != "-") {
+        file.open(options.in, std::ios::binary);
+        if (!file) { std::cerr << "cannot read " << options.in << '\n'; return 1; }
+        file.seekg(options.offset);
+    } else {
+        std::cin.ignore(options.offset);
+    }
+    std::istream& in = options.in == "-" ? std::cin : file;
+    std::ofstream outFile;
+    if (!options.out.empty()) {
+        outFile.open(options.out, std::ios::binary | std::ios::app);
+        if (!outFile) { std::cerr << "cannot write " << options.out << '\n'; return 1; }
+    }
+    std::ostream& out = options.out.empty() ? std::cout : outFile;
+
+    std::vector<std::unique_ptr<Searcher>> searchers, cacheSearchers;
+    for (int t = 0; t < options.threads; ++t) {
+        searchers.emplace_back(new Searcher());
+        searchers.back()->setHashSize(options.hashMb);
+        cacheSearchers.emplace_back(new Searcher());
+        cacheSearchers.back()->setHashSize(CACHE_SEARCH_HASH_MB);
+    }
+    ResultCache cache;
+    std::vector<Game> batch;
+    long long offset = options.offset, games = 0;
+    std::string line;
+    GameRecord record;
+    // Next game into `batch`, if it is not a blank line; false at the end of the input.
+    auto readGame = [&]() {
+        if (records.isOpen()) {
+            if (!records.next(record)) return false;
+            offset = static_cast<long long>(records.offset());
+            batch.push_back({static_cast<long long>(record.offset), offset, gameRecordText(record), ""});
+            return true;
+        }
+        if (!std::getline(in, line)) return false;
+        long long next = offset + static_cast<long long>(line.size()) + (in.eof() ? 0 : 1);
+        if (line.find_first_not_of(" \t\r") != std::string::npos) batch.push_back({offset, next, line, ""});
+        offset = next;
+        return true;
+    };
+    auto start = std::chrono::steady_clock::now();
+    bool more = true;
+    while (more) {
+        batch.clear();
+        while (batch.size() < static_cast<size_t>(options.threads * GAMES_PER_THREAD)) {
+            if (!readGame()) { more = false; break; }
+        }
+        std::atomic<size_t> nextGame{0};
+        auto worker = [&](int id) {
+            for (size_t k; (k = nextGame.fetch_add(1)) < batch.size(); ) annotate(batch[k], *searchers[id], *cacheSearchers[id], cache, options);
+        };
+        std::vector<std::thread> pool;
+        for (int t = 1; t < options.threads; ++t) pool.emplace_back(worker, t);
+        worker(0);
+        for (std::thread& t : pool) t.join();
+        for (const Game& g : batch) out << g.result << '\n';
+        out.flush();
+        games += static_cast<long long>(batch.size());
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << "\r" << games << " games, " << std::fixed << std::setprecision(1) << (seconds > 0 ? games / seconds : 0) << " games/sec, next offset "
+                  << offset << std::flush;
+    }
+    std::cerr << "\ncache: " << cache.size() << " positions, " << cache.hits() << " hits\n";
+    if (records.corrupt()) { std::cerr << "malformed game record at offset " << offset << '\n'; return 1; }
+    return out ? 0 : 1;
+}
@@ -8,42 +8,55 @@ AudioManager&AudioManager::getInstance() {
 	}
 	return*instance;
 }
-bool AudioManager::loadSound(const std::string& name, const std::string& filename) {
-	sf::SoundBuffer buffer;
-	if(!buffer.loadFromFile(filename)){
+bool AudioManager::loadSound(SoundType type, const std::string& filename) {
+	int index = static_cast<int>(type);
+	if(!buffers[index].loadFromFile(filename)){
 		std::cerr << "Failed to load sound:" << filename << std::endl;
+		loaded[index] = false;
 		return false;
 	}
-	buffers[name] = buffer;
-	sf::Sound sound;
-	sound.setBuffer(buffers[name]);
-	sound.setVolume(volume);
-	sounds[name] = sound;
+	loaded[index] = true;
 	return true;
 }
-void AudioManager::playSound(const std::string& name) {
-	if (!enabled)return;
-	auto it = sounds.find(name);
-	if (it != sounds.end()) {
-		it->second.stop();
-		it->second.play();
+void AudioManager::playSound(SoundType type) {
+	int index = static_cast<int>(type);
+	if (!enabled || !loaded[index])return;
+	// a free voice, else the one started longest ago
+	Voice* chosen = &voices[0];
+	for (auto& voice : voices) {
+		if (!voice.sound || voice.sound->getStatus() != sf::SoundSource::Status::Playing) { chosen = &voice; break; }
+		if (voice.started < chosen->started) chosen = &voice;
 	}
+	if (chosen->sound) {
+		chosen->sound->stop();
+		chosen->sound->setBuffer(buffers[index]);
+	} else {
+#if defined(SFML_VERSION_MAJOR) && (SFML_VERSION_MAJOR >= 3)
+		chosen->sound.emplace(buffers[index]);
+#else
+		chosen->sound.emplace();
+		chosen->sound->setBuffer(buffers[index]);
+#endif
+	}
+	chosen->sound->setVolume(volume);
+	chosen->sound->play();
+	chosen->started = ++playCount;
 }
 void AudioManager::setVolume(float vol) {
 	volume = vol;
-	for (auto& pair : sounds) {
-		pair.second.setVolume(volume);
+	for (auto& voice : voices) {
+		if (voice.sound) voice.sound->setVolume(volume);
 	}
 }
 void AudioManager::stopAll() {
-	for (auto& pair : sounds) {
-		pair.second.stop();
+	for (auto& voice : voices) {
+		if (voice.sound) voice.sound->stop();
 	}
 }
 void AudioManager::cleanup() {
 	stopAll();
-	buffers.clear();
-	sounds.clear();
+	for (auto& voice : voices) voice.sound.reset();  // before the buffers they point to
+	loaded.fill(false);
 }
 
 // New setter to match header (keeps backward compatibility if called elsewhere)
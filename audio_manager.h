@@ -1,12 +1,26 @@
 #ifndef AUDIO_MANAGER_H
 #define AUDIO_MANAGER_H
 #include<SFML/Audio.hpp>
-#include<map>
+#include<array>
+#include<optional>
 #include<string>
+#include"sound_definition.h"
+// Fixed pool of voices shared by all sound types: overlapping effects (e.g. several discs placed
+// in quick succession) play together instead of cutting each other off. A new sound takes a free
+// voice, or else the one started longest ago. Buffers are indexed by SoundType, so playSound does
+// no lookup beyond an array index.
 class AudioManager {
 private:
-	std::map<std::string, sf::SoundBuffer>buffers;
-	std::map<std::string, sf::Sound>sounds;
+	static const int VOICE_COUNT = 16;
+	static const int SOUND_COUNT = static_cast<int>(SoundType::COUNT);
+	struct Voice {
+		std::optional<sf::Sound> sound;  // created on first use (SFML 3 sounds need a buffer)
+		unsigned long long started = 0;  // play order, for stealing the oldest voice
+	};
+	std::array<sf::SoundBuffer, SOUND_COUNT>buffers;
+	std::array<bool, SOUND_COUNT>loaded{};
+	std::array<Voice, VOICE_COUNT>voices;
+	unsigned long long playCount = 0;
 	float volume;
 	bool enabled;
 	AudioManager();
@@ -15,8 +29,8 @@ public:
 	static AudioManager& getInstance();
 	AudioManager(const AudioManager&) = delete;
 	AudioManager& operator=(const AudioManager&) = delete;
-	bool loadSound(const std::string& name, const std::string& filename);
-	void playSound(const std::string& name);
+	bool loadSound(SoundType type, const std::string& filename);
+	void playSound(SoundType type);
 	void setVolume(float volume);
 	float getVolume()const { return volume; }
 	// Enable or disable audio playback
@@ -26,5 +40,3 @@ public:
 	void cleanup();
 };
 #endif
-
-
@@ -0,0 +1,353 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <thread>
+
+#include "bitboard.h"
+#include "cli_args.h"
+#include "evaluation.h"
+#include "search.h"
+
+// Engine benchmarks, no SFML dependency.
+// Usage:
+//   reversi_bench smp [--threads N] [--ms T]   Lazy SMP nodes/sec scaling for 1, 2, 4 .. N threads
+//   reversi_bench eval [--ms T]                 leaf evaluation: one evaluate() per child vs evaluateBatch
+//                                               over all children of a node, for each supported kernel
+//   reversi_bench perft [--json]                perft suite: leaf counts checked against known values
+//   reversi_bench suite [--ms T] [--json]       perft suite, legalMoves and makeMove/undoMove ns/call and
+//                                               fixed-depth search nodes/sec; exit code 1 on a perft mismatch
+// --json prints one JSON object instead of the tables, for tracking results per commit.
+
+using namespace OthelloEngine;
+
+namespace {
+
+struct BenchPosition {
+    Position pos;
+    Color side;
+};
+
+// Deterministic midgame positions: random playouts from the start position with a fixed seed.
+std::vector<BenchPosition> midgamePositions(int count, int plies) {
+    std::vector<BenchPosition> out;
+    std::mt19937 rng(20240601u);
+    while (static_cast<int>(out.size()) < count) {
+        Position p = Position::initial();
+        Color side = BLACK;
+        int played = 0;
+        while (played < plies) {
+            uint64_t moves = p.legalMoves(side);
+            if (!moves) { side = opponentOf(side); if (!p.legalMoves(side)) break; continue; }
+            MoveList list(moves);
+            p.makeMove(side, list[static_cast<int>(rng() % list.size)]);
+            side = opponentOf(side);
+            ++played;
+        }
+        if (played == plies && p.legalMoves(side)) out.push_back({p, side});
+    }
+    return out;
+}
+
+// Board text: 64 squares row by row from a1 ('X' black, 'O' white, '-' empty), a space, side to move.
+bool parseBoard(const std::string& text, Position& pos, Color& side) {
+    if (text.size() != 66 || text[64] != ' ' || (text[65] != 'X' && text[65] != 'O')) return false;
+    pos.discs[BLACK] = pos.discs[WHITE] = 0;
+    for (int sq = 0; sq < NUM_SQUARES; ++sq) {
+        if (text[sq] == 'X') pos.discs[BLACK] |= squareBit(sq);
+        else if (text[sq] == 'O') pos.discs[WHITE] |= squareBit(sq);
+        else if (text[sq] != '-') return false;
+    }
+    side = text[65] == 'X' ? BLACK : WHITE;
+    return true;
+}
+
+// Leaves `depth` plies down. A pass counts as a ply; a finished game is one leaf wherever it ends.
+unsigned long long perft(Position& pos, Color side, int depth) {
+    uint64_t moves = pos.legalMoves(side);
+    Color opp = opponentOf(side);
+    if (!moves) {
+        if (!pos.legalMoves(opp)) return 1;
+        return depth == 1 ? 1 : perft(pos, opp, depth - 1);
+    }
+    if (depth == 1) return popCount(moves);
+    unsigned long long leaves = 0;
+    for (int sq : MoveList(moves)) {
+        uint64_t flips = pos.makeMove(side, sq);
+        leaves += perft(pos, opp, depth - 1);
+        pos.undoMove(side, sq, flips);
+    }
+    return leaves;
+}
+
+struct PerftCase {
+    const char* name;
+    const char* board;
+    int depth;
+    unsigned long long leaves;
+};
+
+// Start position counts match the published game-tree sizes; the others were cross-checked against a
+// naive array-board move generator. "pass" has white to move with no legal move.
+const PerftCase PERFT_SUITE[] = {
+    {"start", "---------------------------OX------XO--------------------------- X", 10, 24571284ULL},
+    {"midgame-40", "----------X------OX--X--O-OOXO---O-XO-----OOOO-----OXO----X-OOOO X", 6, 1868906ULL},
+    {"midgame-30", "------X-X-XO-XXO-XXXOX-O--OXXOOO-OOXXX-O--OOOOOO------OX-----O-- X", 6, 5113315ULL},
+    {"endgame-20", "--X-OOO---X--O---OOOOO--XXXXXO-OXXXXOOOOXXXX-O-OX-OXXXXX--OOOO-O X", 7, 4038947ULL},
+    {"pass", "XXXXX---XXXOXO--OOOXXOO-OOXOXOOO--OXXOOO-OOOXOOO--OOOOOO--XXX--O O", 9, 909650ULL},
+};
+
+using BenchClock = std::chrono::steady_clock;
+
+const size_t PERFT_COUNT = sizeof(PERFT_SUITE) / sizeof(PERFT_SUITE[0]);
+
+// Parses every perft board; reports the first malformed one and returns false.
+bool loadPerftSuite(std::vector<BenchPosition>& boards) {
+    boards.resize(PERFT_COUNT);
+    for (size_t i = 0; i < PERFT_COUNT; ++i) {
+        if (!parseBoard(PERFT_SUITE[i].board, boards[i].pos, boards[i].side)) {
+            std::cerr << "malformed perft board: " << PERFT_SUITE[i].name << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+// Runs the perft suite on loadPerftSuite's boards; prints a table or JSON members. Returns false on any mismatch.
+bool runPerft(const std::vector<BenchPosition>& boards, bool json) {
+    bool allOk = true;
+    if (json) std::cout << "  \"perft\": [\n";
+    else std::cout << "perft         depth         leaves   ok       ms   leaves/sec\n";
+    for (size_t i = 0; i < PERFT_COUNT; ++i) {
+        const PerftCase& c = PERFT_SUITE[i];
+        Position pos = boards[i].pos;
+        Color side = boards[i].side;
+        BenchClock::time_point start = BenchClock::now();
+        unsigned long long leaves = perft(pos, side, c.depth);
+        double ms = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+        bool ok = leaves == c.leaves;
+        allOk = allOk && ok;
+        long long rate = ms > 0 ? static_cast<long long>(leaves * 1000.0 / ms) : 0;
+        if (json) {
+            std::cout << "    {\"name\": \"" << c.name << "\", \"depth\": " << c.depth << ", \"leaves\": " << leaves
+                      << ", \"expected\": " << c.leaves << ", \"ok\": " << (ok ? "true" : "false") << ", \"ms\": "
+                      << std::fixed << std::setprecision(1) << ms << ", \"leaves_per_sec\": " << rate << "}"
+                      << (i + 1 < PERFT_COUNT ? ",\n" : "\n");
+        } else {
+            std::cout << std::left << std::setw(12) << c.name << std::right << std::setw(7) << c.depth << std::setw(15)
+                      << leaves << "   " << (ok ? "ok " : "BAD") << std::fixed << std::setprecision(1) << std::setw(9)
+                      << ms << std::setw(13) << rate << '\n';
+            if (!ok) std::cout << "  expected " << c.leaves << '\n';
+        }
+    }
+    if (json) std::cout << "  ],\n  \"perft_ok\": " << (allOk ? "true" : "false");
+    return allOk;
+}
+
+int benchSmp(int maxThreads, int ms) {
+    std::vector<BenchPosition> positions = midgamePositions(8, 20);
+    SearchLimits limits;
+    limits.timeMs = ms;
+    std::cout << "threads  nodes/sec      speedup  avg depth\n";
+    std::vector<int> counts;
+    for (int t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+    double baseNps = 0;
+    for (int t : counts) {
+        Searcher searcher;
+        searcher.setHashSize(64);
+        searcher.setThreads(t);
+        unsigned long long nodes = 0;
+        double elapsedMs = 0;
+        int depthSum = 0;
+        for (const BenchPosition& bp : positions) {
+            SearchResult r = searcher.search(bp.pos, bp.side, limits);
+            nodes += r.nodes;
+            elapsedMs += r.elapsedMs;
+            depthSum += r.depth;
+        }
+        double nps = elapsedMs > 0 ? nodes * 1000.0 / elapsedMs : 0;
+        if (t == 1) baseNps = nps;
+        std::cout << std::setw(7) << t << "  " << std::setw(12) << static_cast<long long>(nps)
+                  << "  " << std::setw(9) << std::fixed << std::setprecision(2) << (baseNps > 0 ? nps / baseNps : 0)
+                  << "  " << std::setw(9) << std::setprecision(1) << double(depthSum) / positions.size() << '\n';
+    }
+    return 0;
+}
+
+// Runs `pass` until at least `ms` milliseconds have gone by; returns nanoseconds per item.
+template <class Pass>
+double timePerItem(int ms, long long itemsPerPass, Pass pass) {
+    long long passes = 0;
+    BenchClock::time_point start = BenchClock::now(), end;
+    do { pass(); ++passes; end = BenchClock::now(); } while (end - start < std::chrono::milliseconds(ms));
+    return std::chrono::duration<double, std::nano>(end - start).count() / double(passes * itemsPerPass);
+}
+
+int benchEval(int ms) {
+    // children of depth-1 nodes at several stages of the game, stored node by node
+    std::vector<uint64_t> own, opp;
+    std::vector<int> nodeStart(1, 0);
+    for (int plies : {12, 24, 36, 48}) {
+        for (const BenchPosition& bp : midgamePositions(250, plies)) {
+            Color side = bp.side, child = opponentOf(side);
+            for (int sq : MoveList(bp.pos.legalMoves(side))) {
+                Position p = bp.pos;
+                p.makeMove(side, sq);
+                own.push_back(p.discs[child]);
+                opp.push_back(p.discs[side]);
+            }
+            nodeStart.push_back(static_cast<int>(own.size()));
+        }
+    }
+    long long leaves = static_cast<long long>(own.size());
+    std::vector<int> scores(own.size());
+    volatile long long sink = 0;
+
+    struct Mode { std::string name; std::function<void()> pass; double ns; };
+    std::vector<Mode> modes;
+    modes.push_back({"per-leaf", [&] {
+        long long sum = 0;
+        for (size_t i = 0; i < own.size(); ++i) {
+            Position p;
+            p.discs[BLACK] = own[i];
+            p.discs[WHITE] = opp[i];
+            sum += evaluate(p, BLACK);
+        }
+        sink = sink + sum;
+    }, 0});
+    for (EvalKernel kernel : {EvalKernel::SCALAR, EvalKernel::SSE2, EvalKernel::AVX2}) {
+        if (!evalKernelSupported(kernel)) continue;
+        modes.push_back({std::string("batch ") + evalKernelName(kernel), [&, kernel] {
+            for (size_t n = 0; n + 1 < nodeStart.size(); ++n) {
+                int b = nodeStart[n];
+                evaluateBatch(&own[b], &opp[b], nodeStart[n + 1] - b, &scores[b], kernel);
+            }
+            sink = sink + scores[0];
+        }, 0});
+    }
+
+    // interleaved rounds, fastest round per mode: robust against clock ramps and noisy neighbours
+    const int ROUNDS = 5;
+    timePerItem(ms / 2, leaves, modes[0].pass);  // warm-up
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (Mode& m : modes) {
+            double ns = timePerItem(ms / ROUNDS, leaves, m.pass);
+            if (round == 0 || ns < m.ns) m.ns = ns;
+        }
+    }
+
+    std::cout << leaves << " leaves in " << nodeStart.size() - 1 << " nodes\n";
+    std::cout << "mode            ns/leaf   leaves/sec   speedup\n";
+    for (const Mode& m : modes) {
+        std::cout << std::left << std::setw(14) << m.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(9) << m.ns << "  " << std::setw(11) << static_cast<long long>(1e9 / m.ns)
+                  << "  " << std::setw(8) << std::setprecision(2) << modes[0].ns / m.ns << '\n';
+    }
+    return 0;
+}
+
+int benchPerft(bool json) {
+    std::vector<BenchPosition> boards;
+    if (!loadPerftSuite(boards)) return 1;
+    if (json) std::cout << "{\n";
+    bool ok = runPerft(boards, json);
+    if (json) std::cout << "\n}\n";
+    return ok ? 0 : 1;
+}
+
+int benchSuite(int ms, bool json) {
+    std::vector<BenchPosition> perftBoards;
+    if (!loadPerftSuite(perftBoards)) return 1;
+    if (json) std::cout << "{\n";
+    bool ok = runPerft(perftBoards, json);
+
+    // move generation and make/undo over positions from every stage of the game
+    std::vector<BenchPosition> positions;
+    for (int plies : {8, 20, 32, 44}) {
+        std::vector<BenchPosition> stage = midgamePositions(256, plies);
+        positions.insert(positions.end(), stage.begin(), stage.end());
+    }
+    long long moveCount = 0;
+    for (const BenchPosition& bp : positions) moveCount += popCount(bp.pos.legalMoves(bp.side));
+    volatile uint64_t sink = 0;
+    double legalNs = timePerItem(ms / 4, static_cast<long long>(positions.size()), [&] {
+        uint64_t acc = 0;
+        for (const BenchPosition& bp : positions) acc ^= bp.pos.legalMoves(bp.side);
+        sink = sink ^ acc;
+    });
+    double makeNs = timePerItem(ms / 4, moveCount, [&] {
+        uint64_t acc = 0;
+        for (const BenchPosition& bp : positions) {
+            Position p = bp.pos;
+            for (int sq : MoveList(p.legalMoves(bp.side))) {
+                uint64_t flips = p.makeMove(bp.side, sq);
+                acc ^= p.discs[BLACK];
+                p.undoMove(bp.side, sq, flips);
+            }
+        }
+        sink = sink ^ acc;
+    });
+
+    // fixed-depth search: node counts are reproducible, so nodes/sec compares across commits
+    const int SEARCH_DEPTH = 8;
+    SearchLimits limits;
+    limits.maxDepth = SEARCH_DEPTH;
+    limits.timeMs = 0;
+    limits.endgameEmpties = -1;
+    Searcher searcher;
+    searcher.setHashSize(16);
+    unsigned long long nodes = 0;
+    double searchMs = 0;
+    for (const BenchPosition& bp : midgamePositions(8, 20)) {
+        searcher.clearHash();
+        SearchResult r = searcher.search(bp.pos, bp.side, limits);
+        nodes += r.nodes;
+        searchMs += r.elapsedMs;
+    }
+    long long nps = searchMs > 0 ? static_cast<long long>(nodes * 1000.0 / searchMs) : 0;
+
+    std::cout << std::fixed << std::setprecision(2);
+    if (json) {
+        std::cout << ",\n  \"legal_moves_ns\": " << legalNs << ",\n  \"make_undo_ns\": " << makeNs
+                  << ",\n  \"search\": {\"depth\": " << SEARCH_DEPTH << ", \"nodes\": " << nodes << ", \"ms\": "
+                  << std::setprecision(1) << searchMs << ", \"nodes_per_sec\": " << nps << "}\n}\n";
+    } else {
+        std::cout << "legalMoves        " << std::setw(8) << legalNs << " ns/call\n";
+        std::cout << "makeMove+undo     " << std::setw(8) << makeNs << " ns/move\n";
+        std::cout << "search depth " << SEARCH_DEPTH << "    " << nodes << " nodes, " << std::setprecision(1) << searchMs
+                  << " ms, " << nps << " nodes/sec\n";
+    }
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "smp";
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+    int ms = 500;
+    bool json = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string opt = argv[i];
+        if (opt == "--json") json = true;
+        else if (opt == "--threads" && i + 1 < argc) {
+            if (!parseNumber(std::string(argv[++i]), 1, 1024, threads)) { std::cerr << "bad value for --threads: " << argv[i] << '\n'; return 1; }
+        } else if (opt == "--ms" && i + 1 < argc) {
+            if (!parseNumber(std::string(argv[++i]), 1, 3600000, ms)) { std::cerr << "bad value for --ms: " << argv[i] << '\n'; return 1; }
+        } else { std::cerr << "unknown option: " << opt << '\n'; return 1; }
+    }
+    if (mode == "smp") return benchSmp(threads, ms);
+    if (mode == "eval") return benchEval(ms);
+    if (mode == "perft") return benchPerft(json);
+    if (mode == "suite") return benchSuite(ms, json);
+    std::cerr << "usage: reversi_bench smp [--threads N] [--ms T]\n"
+                 "       reversi_bench eval [--ms T]\n"
+                 "       reversi_bench perft [--json]\n"
+                 "       reversi_bench suite [--ms T] [--json]\n";
+    return 1;
+}
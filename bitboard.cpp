@@ -0,0 +1,106 @@
+#include "bitboard.h"
+
+namespace OthelloEngine {
+
+namespace {
+
+const uint64_t NOT_COL_0 = 0xFEFEFEFEFEFEFEFEULL;  // squares that may receive a +col shift
+const uint64_t NOT_COL_7 = 0x7F7F7F7F7F7F7F7FULL;  // squares that may receive a -col shift
+
+struct Direction { int shift; uint64_t mask; };
+
+// mask = valid destination squares after one step, i.e. excludes the column a shift would wrap into
+const Direction DIRECTIONS[8] = {
+    { 1, NOT_COL_0}, {-1, NOT_COL_7},
+    { 8, ~0ULL},     {-8, ~0ULL},
+    { 9, NOT_COL_0}, {-9, NOT_COL_7},
+    { 7, NOT_COL_7}, {-7, NOT_COL_0},
+};
+
+inline uint64_t shiftBy(uint64_t b, int s) { return s > 0 ? (b << s) : (b >> -s); }
+
+// Kogge-Stone occluded fill: gen plus every square reachable from it through contiguous pro squares.
+inline uint64_t occludedFill(uint64_t gen, uint64_t pro, const Direction& d) {
+    pro &= d.mask;
+    gen |= pro & shiftBy(gen, d.shift);
+    pro &= shiftBy(pro, d.shift);
+    gen |= pro & shiftBy(gen, d.shift * 2);
+    pro &= shiftBy(pro, d.shift * 2);
+    gen |= pro & shiftBy(gen, d.shift * 4);
+    return gen;
+}
+
+// Moves along one axis (both directions): own discs, then a run of `mask` discs, then the target.
+// `mask` is the opponent set, trimmed to the inner columns for axes that move sideways so runs
+// never wrap around the board edge. The run doubles through pre-shifted pairs: 6 steps in 4 shifts.
+template <int S>
+inline uint64_t axisMoves(uint64_t own, uint64_t mask) {
+    uint64_t pairs = mask & (mask << S);
+    uint64_t f = mask & (own << S);
+    f |= mask & (f << S);
+    f |= pairs & (f << (2 * S));
+    f |= pairs & (f << (2 * S));
+    uint64_t moves = f << S;
+    pairs >>= S;
+    f = mask & (own >> S);
+    f |= mask & (f >> S);
+    f |= pairs & (f >> (2 * S));
+    f |= pairs & (f >> (2 * S));
+    return moves | (f >> S);
+}
+
+} // namespace
+
+uint64_t legalMoves(uint64_t own, uint64_t opp) {
+    uint64_t inner = opp & 0x7E7E7E7E7E7E7E7EULL;
+    uint64_t moves = axisMoves<1>(own, inner) | axisMoves<8>(own, opp) | axisMoves<7>(own, inner) | axisMoves<9>(own, inner);
+    return moves & ~(own | opp);
+}
+
+uint64_t computeFlips(uint64_t own, uint64_t opp, int sq) {
+    uint64_t bit = squareBit(sq);
+    if ((own | opp) & bit) return 0;
+    uint64_t flips = 0;
+    for (const Direction& d : DIRECTIONS) {
+        uint64_t run = occludedFill(bit, opp, d) & opp;
+        if (shiftBy(run | bit, d.shift) & d.mask & own) flips |= run;
+    }
+    return flips;
+}
+
+Position Position::initial() {
+    Position p;
+    p.discs[BLACK] = squareBit(squareIndex(3, 4)) | squareBit(squareIndex(4, 3));
+    p.discs[WHITE] = squareBit(squareIndex(3, 3)) | squareBit(squareIndex(4, 4));
+    return p;
+}
+
+std::string squareName(int sq) {
+    return std::string(1, static_cast<char>('a' + squareCol(sq))) + static_cast<char>('1' + squareRow(sq));
+}
+
+int parseSquare(const char* s) {
+    if (!s[0]) return -1;
+    int col = (s[0] | 0x20) - 'a';  // lower-cases letters
+    if (col < 0 || col >= BOARD_DIM || s[1] < '1' || s[1] > '8') return -1;
+    return squareIndex(s[1] - '1', col);
+}
+
+int canonicalize(uint64_t& own, uint64_t& opp) {
+    // images in symmetry order: bits 1 and 2 first, then the transposes of those four
+    uint64_t o[NUM_SYMMETRIES], p[NUM_SYMMETRIES];
+    o[0] = own;                 p[0] = opp;
+    o[1] = flipVertical(own);   p[1] = flipVertical(opp);
+    o[2] = mirrorHorizontal(own); p[2] = mirrorHorizontal(opp);
+    o[3] = mirrorHorizontal(o[1]); p[3] = mirrorHorizontal(p[1]);
+    for (int i = 0; i < 4; ++i) { o[i + 4] = flipDiagonal(o[i]); p[i + 4] = flipDiagonal(p[i]); }
+    int best = 0;
+    for (int i = 1; i < NUM_SYMMETRIES; ++i) {
+        if (o[i] < o[best] || (o[i] == o[best] && p[i] < p[best])) best = i;
+    }
+    own = o[best];
+    opp = p[best];
+    return best;
+}
+
+} // namespace OthelloEngine
@@ -0,0 +1,158 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+#include <cstdint>
+#include <string>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Bitboard position representation shared by the console and GUI front ends.
+// Square index = row * 8 + col, bit 0 is the top-left corner (row 0, col 0).
+
+namespace OthelloEngine {
+
+const int BOARD_DIM = 8;
+const int NUM_SQUARES = 64;
+
+enum Color : int { BLACK = 0, WHITE = 1 };
+
+inline Color opponentOf(Color c) { return c == BLACK ? WHITE : BLACK; }
+inline int squareIndex(int row, int col) { return row * BOARD_DIM + col; }
+inline int squareRow(int sq) { return sq >> 3; }
+inline int squareCol(int sq) { return sq & 7; }
+inline uint64_t squareBit(int sq) { return 1ULL << sq; }
+
+// Standard notation: column letter a-h, row digit 1-8, so "f5" is row 4, col 5.
+std::string squareName(int sq);
+// Square index for a name like "f5" or "F5" (the first two characters of `s`), -1 if it isn't one.
+int parseSquare(const char* s);
+
+inline int popCount(uint64_t b) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return static_cast<int>(__popcnt64(b));
+#else
+    return __builtin_popcountll(b);
+#endif
+}
+
+// Index of the lowest set bit; b must be non-zero.
+inline int lowestSquare(uint64_t b) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx; _BitScanForward64(&idx, b); return static_cast<int>(idx);
+#else
+    return __builtin_ctzll(b);
+#endif
+}
+
+// Pops the lowest set bit of b and returns its square index.
+inline int popLowestSquare(uint64_t& b) { int sq = lowestSquare(b); b &= b - 1; return sq; }
+
+// Board symmetries: (row, col) -> (7 - row, col), (row, 7 - col) and (col, row).
+inline uint64_t flipVertical(uint64_t b) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _byteswap_uint64(b);
+#else
+    return __builtin_bswap64(b);
+#endif
+}
+inline uint64_t mirrorHorizontal(uint64_t b) {
+    b = ((b >> 1) & 0x5555555555555555ULL) | ((b & 0x5555555555555555ULL) << 1);
+    b = ((b >> 2) & 0x3333333333333333ULL) | ((b & 0x3333333333333333ULL) << 2);
+    return ((b >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((b & 0x0F0F0F0F0F0F0F0FULL) << 4);
+}
+inline uint64_t flipDiagonal(uint64_t b) {
+    uint64_t t = (b ^ (b >> 7)) & 0x00AA00AA00AA00AAULL; b ^= t ^ (t << 7);
+    t = (b ^ (b >> 14)) & 0x0000CCCC0000CCCCULL;         b ^= t ^ (t << 14);
+    t = (b ^ (b >> 28)) & 0x00000000F0F0F0F0ULL;         b ^= t ^ (t << 28);
+    return b;
+}
+
+// The 8 symmetries as 3 bits: 1 = flipVertical, 2 = mirrorHorizontal, 4 = flipDiagonal, applied
+// in that order; symmetry 0 is the identity.
+const int NUM_SYMMETRIES = 8;
+inline uint64_t transformBoard(uint64_t b, int sym) {
+    if (sym & 1) b = flipVertical(b);
+    if (sym & 2) b = mirrorHorizontal(b);
+    if (sym & 4) b = flipDiagonal(b);
+    return b;
+}
+inline int transformSquare(int sq, int sym) {
+    int r = squareRow(sq), c = squareCol(sq);
+    if (sym & 1) r = 7 - r;
+    if (sym & 2) c = 7 - c;
+    return (sym & 4) ? squareIndex(c, r) : squareIndex(r, c);
+}
+// Square of the original board that transformSquare(_, sym) maps to `sq`.
+inline int untransformSquare(int sq, int sym) {
+    int r = squareRow(sq), c = squareCol(sq);
+    if (sym & 4) { int t = r; r = c; c = t; }
+    if (sym & 2) c = 7 - c;
+    if (sym & 1) r = 7 - r;
+    return squareIndex(r, c);
+}
+
+// Replaces (own, opp) by its smallest image over the 8 symmetries (compared own first, then opp),
+// so every position shares one representative with its mirror images; returns the symmetry used.
+int canonicalize(uint64_t& own, uint64_t& opp);
+
+// Legal move mask for the side owning `own` against `opp` (Kogge-Stone fills in 8 directions).
+uint64_t legalMoves(uint64_t own, uint64_t opp);
+
+// Discs flipped by `own` playing on `sq`; 0 if the move is illegal or the square occupied.
+uint64_t computeFlips(uint64_t own, uint64_t opp, int sq);
+
+// Fixed-capacity move list filled from a legal-move mask; lives on the stack, never allocates.
+struct MoveList {
+    uint8_t squares[NUM_SQUARES];  // sized for any bit pattern, not just reachable positions
+    int size = 0;
+
+    MoveList() = default;
+    explicit MoveList(uint64_t mask) { while (mask) push(popLowestSquare(mask)); }
+
+    void push(int sq) { squares[size++] = static_cast<uint8_t>(sq); }
+    bool empty() const { return size == 0; }
+    int operator[](int i) const { return squares[i]; }
+    const uint8_t* begin() const { return squares; }
+    const uint8_t* end() const { return squares + size; }
+};
+
+struct Position {
+    uint64_t discs[2];  // indexed by Color
+
+    static Position initial();
+
+    uint64_t occupied() const { return discs[BLACK] | discs[WHITE]; }
+    uint64_t empties() const { return ~occupied(); }
+    int emptyCount() const { return 64 - popCount(occupied()); }
+    int count(Color c) const { return popCount(discs[c]); }
+
+    // 0 = empty, otherwise the owning Color + 1
+    int at(int sq) const {
+        uint64_t bit = squareBit(sq);
+        return (discs[BLACK] & bit) ? 1 : (discs[WHITE] & bit) ? 2 : 0;
+    }
+
+    uint64_t legalMoves(Color c) const { return OthelloEngine::legalMoves(discs[c], discs[opponentOf(c)]); }
+    uint64_t flipsFor(Color c, int sq) const { return computeFlips(discs[c], discs[opponentOf(c)], sq); }
+
+    // Search-side make: computes and applies the flips for `c` on `sq` and returns them so the
+    // caller can unmake with undoMove(c, sq, flips). Assumes the move is legal.
+    uint64_t makeMove(Color c, int sq) { uint64_t f = flipsFor(c, sq); applyMove(c, sq, f); return f; }
+
+    // Places a disc for `c` on `sq` and applies `flips`; undoMove with the same arguments restores it.
+    void applyMove(Color c, int sq, uint64_t flips) {
+        discs[c] |= flips | squareBit(sq);
+        discs[opponentOf(c)] &= ~flips;
+    }
+    void undoMove(Color c, int sq, uint64_t flips) {
+        discs[c] &= ~(flips | squareBit(sq));
+        discs[opponentOf(c)] |= flips;
+    }
+
+    bool operator==(const Position& o) const { return discs[0] == o.discs[0] && discs[1] == o.discs[1]; }
+    bool operator!=(const Position& o) const { return !(*this == o); }
+};
+
+} // namespace OthelloEngine
+
+#endif
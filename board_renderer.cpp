@@ -0,0 +1,125 @@
+#include "board_renderer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using OthelloEngine::BOARD_DIM;
+
+const int DISC_SEGMENTS = 32;       // 圆周最大分段数，小棋子按半径减少
+const float DISC_RADIUS = 0.40f;    // 相对格子边长
+const float DISC_OUTLINE = 3.f / 80.f;  // 描边宽度（向外），相对格子边长
+const float GRID_WIDTH = 2.f;       // 网格线宽（像素）
+
+const sf::Color GREEN1(30, 120, 30), GREEN2(20, 100, 20), GRID(0, 0, 0, 80);
+const sf::Color BLACK_FILL(0, 0, 0), BLACK_OUTLINE(230, 230, 230);
+const sf::Color WHITE_FILL(255, 255, 255), WHITE_OUTLINE(30, 30, 30);
+
+void appendVertex(sf::VertexArray& out, sf::Vector2f p, sf::Color color) {
+    sf::Vertex v;
+    v.position = p;
+    v.color = color;
+    out.append(v);
+}
+
+void appendRect(sf::VertexArray& out, float x, float y, float w, float h, sf::Color color) {
+    appendVertex(out, {x, y}, color);
+    appendVertex(out, {x + w, y}, color);
+    appendVertex(out, {x, y + h}, color);
+    appendVertex(out, {x + w, y}, color);
+    appendVertex(out, {x + w, y + h}, color);
+    appendVertex(out, {x, y + h}, color);
+}
+
+// 单位圆上的分段点，只计算一次
+const sf::Vector2f* unitCircle() {
+    static sf::Vector2f points[DISC_SEGMENTS + 1];
+    static bool ready = false;
+    if (!ready) {
+        for (int i = 0; i <= DISC_SEGMENTS; ++i) {
+            float a = 2.f * 3.14159265f * i / DISC_SEGMENTS;
+            points[i] = {std::cos(a), std::sin(a)};
+        }
+        ready = true;
+    }
+    return points;
+}
+
+// 实心圆加外描边环；多棋盘缩小显示时减少分段，描边不足 1 像素时省略
+void appendDisc(sf::VertexArray& out, sf::Vector2f center, float radius, float outline, sf::Color fill, sf::Color ring) {
+    const sf::Vector2f* u = unitCircle();
+    int step = radius >= 24.f ? 1 : radius >= 10.f ? 2 : 4;
+    float outer = radius + outline;
+    for (int i = 0; i < DISC_SEGMENTS; i += step) {
+        sf::Vector2f a(center.x + u[i].x * radius, center.y + u[i].y * radius);
+        sf::Vector2f b(center.x + u[i + step].x * radius, center.y + u[i + step].y * radius);
+        appendVertex(out, center, fill);
+        appendVertex(out, a, fill);
+        appendVertex(out, b, fill);
+        if (outline < 1.f) continue;
+        sf::Vector2f oa(center.x + u[i].x * outer, center.y + u[i].y * outer);
+        sf::Vector2f ob(center.x + u[i + step].x * outer, center.y + u[i + step].y * outer);
+        appendVertex(out, a, ring);
+        appendVertex(out, oa, ring);
+        appendVertex(out, b, ring);
+        appendVertex(out, b, ring);
+        appendVertex(out, oa, ring);
+        appendVertex(out, ob, ring);
+    }
+}
+
+} // namespace
+
+void appendBoardBackground(sf::VertexArray& out, sf::Vector2f origin, float cell) {
+    float size = BOARD_DIM * cell;
+    for (int r = 0; r < BOARD_DIM; ++r) {
+        for (int c = 0; c < BOARD_DIM; ++c)
+            appendRect(out, origin.x + c * cell, origin.y + r * cell, cell, cell, (r + c) % 2 == 0 ? GREEN1 : GREEN2);
+    }
+    float width = std::max(1.f, GRID_WIDTH * cell / 80.f);
+    for (int i = 0; i <= BOARD_DIM; ++i) {
+        appendRect(out, origin.x + i * cell, origin.y, width, size, GRID);  // 竖线
+        appendRect(out, origin.x, origin.y + i * cell, size, width, GRID);  // 横线
+    }
+}
+
+void appendBoardDiscs(sf::VertexArray& out, sf::Vector2f origin, float cell, uint64_t black, uint64_t white) {
+    for (uint64_t occupied = black | white; occupied; ) {
+        int sq = OthelloEngine::popLowestSquare(occupied);
+        sf::Vector2f center(origin.x + (OthelloEngine::squareCol(sq) + 0.5f) * cell,
+                            origin.y + (OthelloEngine::squareRow(sq) + 0.5f) * cell);
+        bool isBlack = (black >> sq) & 1;
+        appendDisc(out, center, DISC_RADIUS * cell, DISC_OUTLINE * cell,
+                   isBlack ? BLACK_FILL : WHITE_FILL, isBlack ? BLACK_OUTLINE : WHITE_OUTLINE);
+    }
+}
+
+BoardRenderer::BoardRenderer() : background(sf::PrimitiveType::Triangles), discs(sf::PrimitiveType::Triangles) {}
+
+void BoardRenderer::setLayout(sf::Vector2f newOrigin, float newCell) {
+    origin = newOrigin;
+    cell = newCell;
+    backgroundDirty = discsDirty = true;
+}
+
+void BoardRenderer::setPosition(const OthelloEngine::Position& pos) {
+    if (pos.discs[OthelloEngine::BLACK] == black && pos.discs[OthelloEngine::WHITE] == white) return;
+    black = pos.discs[OthelloEngine::BLACK];
+    white = pos.discs[OthelloEngine::WHITE];
+    discsDirty = true;
+}
+
+void BoardRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (backgroundDirty) {
+        background.clear();
+        appendBoardBackground(background, origin, cell);
+        backgroundDirty = false;
+    }
+    if (discsDirty) {
+        discs.clear();
+        appendBoardDiscs(discs, origin, cell, black, white);
+        discsDirty = false;
+    }
+    target.draw(background, states);
+    target.draw(discs, states);
+}
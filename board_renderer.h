@@ -0,0 +1,36 @@
+#ifndef BOARD_RENDERER_H
+#define BOARD_RENDERER_H
+#include <cstdint>
+
+#include <SFML/Graphics.hpp>
+
+#include "bitboard.h"
+
+// 棋盘绘制：格子、网格线和棋子都预先生成为三角形顶点数组，只在布局或棋子变化时重建，
+// 每帧只需两次 draw 调用。
+//
+// 追加函数把一块棋盘的几何写入调用方的顶点数组（PrimitiveType::Triangles），
+// 多块棋盘可以共用同一个数组，一次 draw 画完。origin 为棋盘左上角，cell 为格子边长。
+void appendBoardBackground(sf::VertexArray& out, sf::Vector2f origin, float cell);
+void appendBoardDiscs(sf::VertexArray& out, sf::Vector2f origin, float cell, uint64_t black, uint64_t white);
+
+class BoardRenderer : public sf::Drawable {
+public:
+    BoardRenderer();
+
+    // 设置位置与尺寸；两层几何都会在下次 draw 前重建
+    void setLayout(sf::Vector2f origin, float cell);
+    // 棋子未变化时不做任何事
+    void setPosition(const OthelloEngine::Position& pos);
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    sf::Vector2f origin;
+    float cell = 0.f;
+    uint64_t black = 0, white = 0;
+    mutable bool backgroundDirty = true, discsDirty = true;
+    mutable sf::VertexArray background, discs;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "bitboard.h"
+#include "cli_args.h"
+#include "opening_book.h"
+
+// Opening book builder and viewer, no SFML dependency.
+// Usage:
+//   reversi_book build GAMES BOOK [--plies N] [--min-games N]
+//       GAMES: one game per line as concatenated squares, e.g. f5d6c3d3c4f4... ("-" reads stdin)
+//   reversi_book probe BOOK [MOVES]
+//       book moves after MOVES (same notation; empty = start position)
+
+using namespace OthelloEngine;
+
+namespace {
+
+int usage() {
+    std::cerr << "usage: reversi_book build GAMES BOOK [--plies N] [--min-games N]\n"
+                 "       reversi_book probe BOOK [MOVES]\n";
+    return 1;
+}
+
+int build(int argc, char** argv) {
+    if (argc < 4) return usage();
+    BookBuildOptions options;
+    for (int i = 4; i < argc; i += 2) {
+        std::string opt = argv[i];
+        if (i + 1 >= argc) return usage();
+        std::string val = argv[i + 1];
+        bool ok = true;
+        if (opt == "--plies") ok = parseNumber(val, 1, 60, options.maxPlies);
+        else if (opt == "--min-games") ok = parseNumber(val, 1, 1000000000, options.minGames);
+        else return usage();
+        if (!ok) { std::cerr << "bad value for " << opt << ": " << val << '\n'; return usage(); }
+    }
+    std::string in = argv[2];
+    std::ifstream file;
+    if (in != "-") {
+        file.open(in);
+        if (!file) { std::cerr << "cannot read " << in << '\n'; return 1; }
+    }
+    BookBuildStats stats;
+    if (!buildOpeningBook(in == "-" ? std::cin : file, argv[3], options, &stats)) {
+        std::cerr << "cannot write " << argv[3] << '\n';
+        return 1;
+    }
+    std::cout << stats.games << " games (" << stats.skipped << " illegal lines skipped), " << stats.positions
+              << " positions, " << stats.moves << " moves\n";
+    return 0;
+}
+
+int probe(int argc, char** argv) {
+    if (argc < 3) return usage();
+    OpeningBook book;
+    if (!book.open(argv[2])) { std::cerr << "cannot open book " << argv[2] << '\n'; return 1; }
+    Position pos = Position::initial();
+    Color side = BLACK;
+    std::string moves = argc > 3 ? argv[3] : "";
+    for (size_t i = 0; i + 1 < moves.size(); i += 2) {
+        if (!pos.legalMoves(side)) side = opponentOf(side);
+        int sq = parseSquare(moves.c_str() + i);
+        if (sq < 0 || !(pos.legalMoves(side) & squareBit(sq))) { std::cerr << "illegal move " << moves.substr(i, 2) << '\n'; return 1; }
+        pos.makeMove(side, sq);
+        side = opponentOf(side);
+    }
+    if (!pos.legalMoves(side)) side = opponentOf(side);
+    std::cout << book.positionCount() << " positions in book; " << (side == BLACK ? "black" : "white") << " to move\n";
+    for (const BookMove& m : book.lookup(pos, side)) {
+        std::cout << squareName(m.square) << "  games " << m.games << "  score "
+                  << (m.games ? 50.0 * m.points / m.games : 0) << "%\n";
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "build") return build(argc, argv);
+    if (mode == "probe") return probe(argc, argv);
+    return usage();
+}
@@ -0,0 +1,21 @@
+#ifndef CLI_ARGS_H
+#define CLI_ARGS_H
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+
+// Numeric command-line values for the tools. Unlike std::stoi this never throws: the whole argument
+// must be a decimal integer in [lo, hi], otherwise it returns false and leaves `out` unchanged.
+template <typename T>
+bool parseNumber(const std::string& text, T lo, T hi, T& out) {
+    if (text.empty()) return false;
+    errno = 0;
+    char* end = nullptr;
+    long long value = std::strtoll(text.c_str(), &end, 10);
+    if (errno == ERANGE || *end != '\0') return false;
+    if (value < static_cast<long long>(lo) || value > static_cast<long long>(hi)) return false;
+    out = static_cast<T>(value);
+    return true;
+}
+
+#endif
@@ -0,0 +1,261 @@
+#include "endgame.h"
+#include <cstddef>
+#include <utility>
+
+namespace OthelloEngine {
+
+namespace {
+
+const int SCORE_MAX = 65;             // outside the -64..64 disc-differential range
+const int FASTEST_FIRST_EMPTIES = 7;  // above this, order by opponent mobility; at or below, parity only
+const int STABILITY_MIN_EMPTIES = 8;
+const int HASH_MIN_EMPTIES = 10;
+
+const uint64_t COL_0 = 0x0101010101010101ULL;
+const uint64_t ROW_0 = 0x00000000000000FFULL;
+const uint64_t NOT_COL_0 = ~COL_0;
+const uint64_t NOT_COL_7 = ~(COL_0 << 7);
+const uint64_t EDGES = COL_0 | (COL_0 << 7) | ROW_0 | (ROW_0 << 56);
+
+inline int discDiff(uint64_t own, uint64_t opp) { return popCount(own) - popCount(opp); }
+
+// Quadrant 0..3 of a square: bit 1 = bottom half, bit 0 = right half.
+inline int quadrantOf(int sq) { return ((sq >> 5) & 1) * 2 + ((sq >> 2) & 1); }
+
+// Bitmask of quadrants holding an odd number of empties.
+inline int oddQuadrants(uint64_t empty) {
+    static const uint64_t QUADRANTS[4] = {
+        0x000000000F0F0F0FULL, 0x00000000F0F0F0F0ULL, 0x0F0F0F0F00000000ULL, 0xF0F0F0F000000000ULL
+    };
+    int parity = 0;
+    for (int q = 0; q < 4; ++q) if (popCount(empty & QUADRANTS[q]) & 1) parity |= 1 << q;
+    return parity;
+}
+
+// Squares whose line along each axis is completely occupied.
+struct FullLines { uint64_t horizontal, vertical, diag9, diag7; };
+
+FullLines fullLines(uint64_t occupied) {
+    FullLines f = {0, 0, 0, 0};
+    for (int i = 0; i < 8; ++i) {
+        uint64_t row = ROW_0 << (8 * i);
+        if ((occupied & row) == row) f.horizontal |= row;
+        uint64_t col = COL_0 << i;
+        if ((occupied & col) == col) f.vertical |= col;
+    }
+    // diagonals, one per starting square on the top row / left column
+    for (int start = 0; start < 15; ++start) {
+        uint64_t d9 = 0, d7 = 0;
+        for (int r = 0; r < 8; ++r) {
+            int c9 = start - 7 + r;  // r - c constant
+            if (c9 >= 0 && c9 < 8) d9 |= squareBit(squareIndex(r, c9));
+            int c7 = start - r;      // r + c constant
+            if (c7 >= 0 && c7 < 8) d7 |= squareBit(squareIndex(r, c7));
+        }
+        if ((occupied & d9) == d9) f.diag9 |= d9;
+        if ((occupied & d7) == d7) f.diag7 |= d7;
+    }
+    return f;
+}
+
+// Fastest-first (fewest opponent replies) far from the end, odd-quadrant parity as the tie-break / near the end.
+void orderMoves(uint64_t own, uint64_t opp, MoveList& list) {
+    uint64_t empty = ~(own | opp);
+    bool fastestFirst = popCount(empty) > FASTEST_FIRST_EMPTIES;
+    int parity = oddQuadrants(empty);
+    int keys[NUM_SQUARES];
+    for (int i = 0; i < list.size; ++i) {
+        int sq = list[i];
+        int key = (parity & (1 << quadrantOf(sq))) ? 1 : 0;
+        if (fastestFirst) {
+            uint64_t f = computeFlips(own, opp, sq);
+            key -= popCount(legalMoves(opp & ~f, own | f | squareBit(sq))) * 4;
+        }
+        int j = i;
+        while (j > 0 && keys[j - 1] < key) { keys[j] = keys[j - 1]; list.squares[j] = list.squares[j - 1]; --j; }
+        keys[j] = key;
+        list.squares[j] = static_cast<uint8_t>(sq);
+    }
+}
+
+} // namespace
+
+uint64_t stableDiscs(uint64_t own, uint64_t opp) {
+    // A disc is stable when on every axis its line is full, it touches the edge, or it has a stable
+    // neighbour of the same colour; iterate to a fixed point starting from nothing.
+    FullLines full = fullLines(own | opp);
+    uint64_t h0 = full.horizontal | COL_0 | (COL_0 << 7);
+    uint64_t v0 = full.vertical | ROW_0 | (ROW_0 << 56);
+    uint64_t d90 = full.diag9 | EDGES;
+    uint64_t d70 = full.diag7 | EDGES;
+    uint64_t stable = 0, prev;
+    do {
+        prev = stable;
+        uint64_t h = h0 | ((stable << 1) & NOT_COL_0) | ((stable >> 1) & NOT_COL_7);
+        uint64_t v = v0 | (stable << 8) | (stable >> 8);
+        uint64_t d9 = d90 | ((stable << 9) & NOT_COL_0) | ((stable >> 9) & NOT_COL_7);
+        uint64_t d7 = d70 | ((stable << 7) & NOT_COL_7) | ((stable >> 7) & NOT_COL_0);
+        stable = own & h & v & d9 & d7;
+    } while (stable != prev);
+    return stable;
+}
+
+void EndgameSolver::setHashBytes(size_t bytes) {
+    hashBits = 10;
+    while (hashBits < 40 && (sizeof(HashEntry) << (hashBits + 1)) <= bytes) ++hashBits;
+    std::vector<HashEntry>().swap(table);
+}
+
+EndgameSolver::HashEntry& EndgameSolver::hashSlot(uint64_t own, uint64_t opp) {
+    if (table.empty()) table.assign(std::size_t(1) << hashBits, HashEntry{0, 0, -64, 64, -1});
+    uint64_t h = own * 0x9E3779B97F4A7C15ULL ^ (opp + 0x632BE59BD9B4E019ULL) * 0xC2B2AE3D27D4EB4FULL;
+    return table[(h ^ (h >> 29)) & (table.size() - 1)];
+}
+
+bool EndgameSolver::checkStop() {
+    if (stopped || (++polls & 1023) != 0) return stopped;
+    if (stopFlag && stopFlag->load(std::memory_order_relaxed)) stopped = true;
+    if (hasDeadline && std::chrono::steady_clock::now() >= deadline) stopped = true;
+    return stopped;
+}
+
+int EndgameSolver::solveLast1(uint64_t own, uint64_t opp, int sq) {
+    ++nodes;
+    int base = discDiff(own, opp);
+    uint64_t f = computeFlips(own, opp, sq);
+    if (f) return base + 1 + 2 * popCount(f);
+    f = computeFlips(opp, own, sq);
+    if (f) return base - 1 - 2 * popCount(f);
+    return base;
+}
+
+// 0..4 empties: walk the empty squares directly (parity order), no legal-move generation.
+int EndgameSolver::solveShallow(uint64_t own, uint64_t opp, int alpha, int beta, bool passed) {
+    uint64_t empty = ~(own | opp);
+    if (!empty) { ++nodes; return discDiff(own, opp); }  // the move before filled the board
+    if (!(empty & (empty - 1))) return solveLast1(own, opp, lowestSquare(empty));
+    ++nodes;
+
+    int squares[4], n = 0;
+    int parity = oddQuadrants(empty);
+    for (uint64_t e = empty; e; ) { int sq = popLowestSquare(e); if (parity & (1 << quadrantOf(sq))) squares[n++] = sq; }
+    for (uint64_t e = empty; e; ) { int sq = popLowestSquare(e); if (!(parity & (1 << quadrantOf(sq)))) squares[n++] = sq; }
+
+    int best = -SCORE_MAX;
+    for (int i = 0; i < n; ++i) {
+        int sq = squares[i];
+        uint64_t f = computeFlips(own, opp, sq);
+        if (!f) continue;
+        int score = -solveShallow(opp & ~f, own | f | squareBit(sq), -beta, -alpha, false);
+        if (score > best) {
+            best = score;
+            if (best > alpha) { alpha = best; if (alpha >= beta) return best; }
+        }
+    }
+    if (best == -SCORE_MAX) {
+        if (passed) return discDiff(own, opp);
+        return -solveShallow(opp, own, -beta, -alpha, true);
+    }
+    return best;
+}
+
+int EndgameSolver::solveWindow(uint64_t own, uint64_t opp, int alpha, int beta, bool passed) {
+    if (checkStop()) return 0;
+    uint64_t empty = ~(own | opp);
+    int n = popCount(empty);
+    if (n <= 4) return solveShallow(own, opp, alpha, beta, passed);
+    ++nodes;
+
+    // stability cutoff: the opponent's stable discs cap our best possible result
+    if (n >= STABILITY_MIN_EMPTIES && alpha > 0) {
+        int maxScore = 64 - 2 * popCount(stableDiscs(opp, own));
+        if (maxScore <= alpha) return maxScore;
+    }
+
+    HashEntry* entry = nullptr;
+    int hashMove = -1;
+    if (n >= HASH_MIN_EMPTIES) {
+        entry = &hashSlot(own, opp);
+        if (entry->own == own && entry->opp == opp) {
+            if (entry->lower >= beta) return entry->lower;
+            if (entry->upper <= alpha) return entry->upper;
+            if (entry->lower == entry->upper) return entry->lower;
+            if (entry->lower > alpha) alpha = entry->lower;
+            if (entry->upper < beta) beta = entry->upper;
+            hashMove = entry->move;
+        }
+    }
+    int alphaOrig = alpha;
+
+    uint64_t moves = legalMoves(own, opp);
+    if (!moves) {
+        if (passed) return discDiff(own, opp);
+        return -solveWindow(opp, own, -beta, -alpha, true);
+    }
+
+    MoveList list(moves);
+    orderMoves(own, opp, list);
+    for (int i = 1; i < list.size; ++i) {
+        if (list[i] == hashMove) { std::swap(list.squares[0], list.squares[i]); break; }
+    }
+
+    // principal variation search: null window after the first move, re-search on fail high
+    int best = -SCORE_MAX, bestSq = list[0];
+    for (int i = 0; i < list.size; ++i) {
+        int sq = list[i];
+        uint64_t f = computeFlips(own, opp, sq);
+        uint64_t nOwn = opp & ~f, nOpp = own | f | squareBit(sq);
+        int score;
+        if (i == 0) {
+            score = -solveWindow(nOwn, nOpp, -beta, -alpha, false);
+        } else {
+            score = -solveWindow(nOwn, nOpp, -alpha - 1, -alpha, false);
+            if (score > alpha && score < beta) score = -solveWindow(nOwn, nOpp, -beta, -alpha, false);
+        }
+        if (stopped) return 0;
+        if (score > best) {
+            best = score; bestSq = sq;
+            if (best > alpha) { alpha = best; if (alpha >= beta) break; }
+        }
+    }
+
+    if (entry) {
+        int lower = best > alphaOrig ? best : -64;
+        int upper = best < beta ? best : 64;
+        if (entry->own == own && entry->opp == opp) {
+            if (entry->lower > lower) lower = entry->lower;
+            if (entry->upper < upper) upper = entry->upper;
+        }
+        *entry = HashEntry{own, opp, static_cast<int8_t>(lower), static_cast<int8_t>(upper), static_cast<int8_t>(bestSq)};
+    }
+    return best;
+}
+
+int EndgameSolver::solve(const Position& pos, Color side, int& bestMove) {
+    uint64_t own = pos.discs[side], opp = pos.discs[opponentOf(side)];
+    bestMove = -1;
+    uint64_t moves = legalMoves(own, opp);
+    if (!moves) return solveWindow(own, opp, -SCORE_MAX, SCORE_MAX, false);
+
+    MoveList list(moves);
+    orderMoves(own, opp, list);
+    int alpha = -SCORE_MAX, best = -SCORE_MAX;
+    bestMove = list[0];
+    for (int i = 0; i < list.size; ++i) {
+        int sq = list[i];
+        uint64_t f = computeFlips(own, opp, sq);
+        uint64_t nOwn = opp & ~f, nOpp = own | f | squareBit(sq);
+        int score;
+        if (i == 0) {
+            score = -solveWindow(nOwn, nOpp, -SCORE_MAX, SCORE_MAX, false);
+        } else {
+            score = -solveWindow(nOwn, nOpp, -alpha - 1, -alpha, false);
+            if (score > alpha) score = -solveWindow(nOwn, nOpp, -SCORE_MAX, -alpha, false);
+        }
+        if (stopped) return 0;
+        if (score > best) { best = score; bestMove = sq; if (best > alpha) alpha = best; }
+    }
+    return best;
+}
+
+} // namespace OthelloEngine
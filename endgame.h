@@ -0,0 +1,66 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "bitboard.h"
+
+namespace OthelloEngine {
+
+// Discs of `own` that can never be flipped again (edge/corner anchored and full-line stability).
+uint64_t stableDiscs(uint64_t own, uint64_t opp);
+
+// Exact endgame solver. Scores are final disc differentials (own - opponent), not DISC_SCORE units.
+// Move ordering is fastest-first with quadrant parity far from the end, parity only near it;
+// the last four empties use dedicated routines that skip move generation entirely. Nodes with
+// many empties keep bounds in a private hash table keyed by the exact (own, opp) pair.
+class EndgameSolver {
+public:
+    // `stop` (optional) and the deadline (see setDeadline) are polled every thousand or so interior
+    // nodes; when either trips the solve returns early and aborted() reports it, the score is then
+    // meaningless. The hash table holds 2^hashBits 24-byte entries (24 MB at the default 20) and is
+    // allocated on first use; Searcher sizes it from its hash budget through setHashBytes.
+    explicit EndgameSolver(const std::atomic<bool>* stop = nullptr, int hashBits = 20)
+        : stopFlag(stop), hashBits(hashBits) {}
+
+    // Exact score for `side` to move, with the best move in bestMove (-1 = pass / game over).
+    int solve(const Position& pos, Color side, int& bestMove);
+    // Score of `own` to move, exact inside (alpha, beta), a bound outside it.
+    int solveWindow(uint64_t own, uint64_t opp, int alpha, int beta, bool passed);
+
+    unsigned long long nodes = 0;
+    bool aborted() const { return stopped; }
+    // Clears the abort state and the deadline so the solver (and its hash table) can be reused.
+    void reset() { stopped = false; nodes = 0; polls = 0; hasDeadline = false; }
+    // Aborts the next solve once the clock passes `time`; reset() removes it.
+    void setDeadline(std::chrono::steady_clock::time_point time) { deadline = time; hasDeadline = true; }
+    // Largest power-of-two table that fits in `bytes` (at least 1024 entries); frees the current one,
+    // the new one is allocated on first use.
+    void setHashBytes(size_t bytes);
+
+private:
+    struct HashEntry {
+        uint64_t own, opp;
+        int8_t lower, upper;
+        int8_t move;
+    };
+
+    int solveLast1(uint64_t own, uint64_t opp, int sq);
+    int solveShallow(uint64_t own, uint64_t opp, int alpha, int beta, bool passed);
+    bool checkStop();
+
+    HashEntry& hashSlot(uint64_t own, uint64_t opp);
+
+    const std::atomic<bool>* stopFlag;
+    bool stopped = false;
+    bool hasDeadline = false;
+    std::chrono::steady_clock::time_point deadline;
+    unsigned polls = 0;
+    int hashBits;
+    std::vector<HashEntry> table;
+};
+
+} // namespace OthelloEngine
+
+#endif
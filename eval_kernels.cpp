@@ -0,0 +1,15 @@
+#include "eval_kernels.h"
+
+namespace OthelloEngine {
+
+void boardTermsScalar(const uint64_t* own, const uint64_t* opp, int count, BoardTerms& out) {
+    boardTermsKernel<Lane64>(own, opp, count, out);
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+void boardTermsSse2(const uint64_t* own, const uint64_t* opp, int count, BoardTerms& out) {
+    boardTermsKernel<Lane128>(own, opp, count, out);
+}
+#endif
+
+} // namespace OthelloEngine
@@ -0,0 +1,140 @@
+#ifndef EVAL_KERNELS_H
+#define EVAL_KERNELS_H
+#include <cstdint>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Internal to the evaluation: board-wide terms for a batch of positions, computed several positions
+// per SIMD register. Each kernel translation unit instantiates boardTermsKernel with its own lane type
+// and compiler flags; everything here is in an anonymous namespace so no instruction-set-specific
+// copy of a shared inline function can leak into other translation units.
+
+namespace OthelloEngine {
+
+const int EVAL_BATCH = 64;  // positions per kernel call; larger batches are split
+
+// Structure of arrays, one entry per position of the batch.
+struct BoardTerms {
+    uint64_t ownMoves[EVAL_BATCH], oppMoves[EVAL_BATCH];
+    uint64_t ownFrontier[EVAL_BATCH], oppFrontier[EVAL_BATCH];  // empties next to the other side's discs
+    uint64_t tOwn[EVAL_BATCH], tOpp[EVAL_BATCH];                // transposed boards
+};
+
+typedef void (*BoardTermsFn)(const uint64_t* own, const uint64_t* opp, int count, BoardTerms& out);
+
+void boardTermsScalar(const uint64_t* own, const uint64_t* opp, int count, BoardTerms& out);
+#if defined(__x86_64__) || defined(_M_X64)
+void boardTermsSse2(const uint64_t* own, const uint64_t* opp, int count, BoardTerms& out);
+#endif
+// CMake defines OTHELLO_AVX2_KERNEL only on x86-64, where it also builds eval_kernels_avx2.cpp with
+// AVX2; the kernel exists exactly when this holds, so every reference to it is guarded by it.
+#if defined(OTHELLO_AVX2_KERNEL) && (defined(__x86_64__) || defined(_M_X64))
+#define OTHELLO_HAS_AVX2_KERNEL 1
+#endif
+
+#if defined(OTHELLO_HAS_AVX2_KERNEL)
+// Built with AVX2 enabled (eval_kernels_avx2.cpp); only call it after checking the CPU.
+void boardTermsAvx2(const uint64_t* own, const uint64_t* opp, int count, BoardTerms& out);
+#endif
+
+namespace {
+
+// Lane types share one interface: splat constructor, load/store, bitwise operators, shifts.
+struct Lane64 {
+    static const int LANES = 1;
+    uint64_t v;
+    explicit Lane64(uint64_t x) : v(x) {}
+    static Lane64 load(const uint64_t* p) { return Lane64(*p); }
+    void store(uint64_t* p) const { *p = v; }
+    friend Lane64 operator&(Lane64 a, Lane64 b) { return Lane64(a.v & b.v); }
+    friend Lane64 operator|(Lane64 a, Lane64 b) { return Lane64(a.v | b.v); }
+    friend Lane64 operator^(Lane64 a, Lane64 b) { return Lane64(a.v ^ b.v); }
+    friend Lane64 operator<<(Lane64 a, int n) { return Lane64(a.v << n); }
+    friend Lane64 operator>>(Lane64 a, int n) { return Lane64(a.v >> n); }
+};
+
+#if defined(__x86_64__) || defined(_M_X64)
+// Two positions per register; SSE2 is part of the x86-64 baseline, so this needs no CPU check.
+struct Lane128 {
+    static const int LANES = 2;
+    __m128i v;
+    explicit Lane128(__m128i x) : v(x) {}
+    explicit Lane128(uint64_t x) : v(_mm_set1_epi64x(static_cast<long long>(x))) {}
+    static Lane128 load(const uint64_t* p) { return Lane128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+    void store(uint64_t* p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    friend Lane128 operator&(Lane128 a, Lane128 b) { return Lane128(_mm_and_si128(a.v, b.v)); }
+    friend Lane128 operator|(Lane128 a, Lane128 b) { return Lane128(_mm_or_si128(a.v, b.v)); }
+    friend Lane128 operator^(Lane128 a, Lane128 b) { return Lane128(_mm_xor_si128(a.v, b.v)); }
+    friend Lane128 operator<<(Lane128 a, int n) { return Lane128(_mm_slli_epi64(a.v, n)); }
+    friend Lane128 operator>>(Lane128 a, int n) { return Lane128(_mm_srli_epi64(a.v, n)); }
+};
+#endif
+
+template <class V>
+inline V axisMoves(V own, V mask, int s) {
+    V pairs = mask & (mask << s);
+    V f = mask & (own << s);
+    f = f | (mask & (f << s));
+    f = f | (pairs & (f << (2 * s)));
+    f = f | (pairs & (f << (2 * s)));
+    V moves = f << s;
+    pairs = pairs >> s;
+    f = mask & (own >> s);
+    f = f | (mask & (f >> s));
+    f = f | (pairs & (f >> (2 * s)));
+    f = f | (pairs & (f >> (2 * s)));
+    return moves | (f >> s);
+}
+
+template <class V>
+inline V kernelLegalMoves(V own, V opp, V empty) {
+    V inner = opp & V(0x7E7E7E7E7E7E7E7EULL);
+    return (axisMoves(own, inner, 1) | axisMoves(own, opp, 8) | axisMoves(own, inner, 7) | axisMoves(own, inner, 9)) & empty;
+}
+
+template <class V>
+inline V kernelNeighbours(V b) {
+    V h = ((b << 1) & V(0xFEFEFEFEFEFEFEFEULL)) | ((b >> 1) & V(0x7F7F7F7F7F7F7F7FULL));
+    V row = b | h;
+    return h | (row << 8) | (row >> 8);
+}
+
+template <class V>
+inline V kernelFlipDiagonal(V b) {
+    V t = (b ^ (b >> 7)) & V(0x00AA00AA00AA00AAULL);  b = b ^ t ^ (t << 7);
+    t = (b ^ (b >> 14)) & V(0x0000CCCC0000CCCCULL);     b = b ^ t ^ (t << 14);
+    t = (b ^ (b >> 28)) & V(0x00000000F0F0F0F0ULL);     return b ^ t ^ (t << 28);
+}
+
+// Positions [i, count) in steps of V::LANES while a full step fits; returns where it stopped.
+template <class V>
+inline int boardTermsLanes(const uint64_t* own, const uint64_t* opp, int i, int count, BoardTerms& out) {
+    for (; i + V::LANES <= count; i += V::LANES) {
+        V o = V::load(own + i), p = V::load(opp + i);
+        V empty = (o | p) ^ V(~0ULL);
+        kernelLegalMoves(o, p, empty).store(out.ownMoves + i);
+        kernelLegalMoves(p, o, empty).store(out.oppMoves + i);
+        (kernelNeighbours(p) & empty).store(out.ownFrontier + i);
+        (kernelNeighbours(o) & empty).store(out.oppFrontier + i);
+        kernelFlipDiagonal(o).store(out.tOwn + i);
+        kernelFlipDiagonal(p).store(out.tOpp + i);
+    }
+    return i;
+}
+
+// Full registers with V, then narrower registers for the remainder. count <= EVAL_BATCH.
+template <class V>
+inline void boardTermsKernel(const uint64_t* own, const uint64_t* opp, int count, BoardTerms& out) {
+    int i = boardTermsLanes<V>(own, opp, 0, count, out);
+#if defined(__x86_64__) || defined(_M_X64)
+    if (V::LANES > Lane128::LANES) i = boardTermsLanes<Lane128>(own, opp, i, count, out);
+#endif
+    boardTermsLanes<Lane64>(own, opp, i, count, out);
+}
+
+} // namespace
+
+} // namespace OthelloEngine
+
+#endif
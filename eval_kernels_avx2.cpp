@@ -0,0 +1,37 @@
+#include "eval_kernels.h"
+
+// Compiled with AVX2 enabled (see CMakeLists.txt); outside x86-64 builds this file is empty and
+// the evaluation falls back to the SSE2 / scalar kernels.
+#if defined(OTHELLO_HAS_AVX2_KERNEL)
+#if !defined(__AVX2__)
+#error "eval_kernels_avx2.cpp must be compiled with AVX2 enabled (-mavx2 / /arch:AVX2)"
+#endif
+#include <immintrin.h>
+
+namespace OthelloEngine {
+
+namespace {
+
+// Four positions per register.
+struct Lane256 {
+    static const int LANES = 4;
+    __m256i v;
+    explicit Lane256(__m256i x) : v(x) {}
+    explicit Lane256(uint64_t x) : v(_mm256_set1_epi64x(static_cast<long long>(x))) {}
+    static Lane256 load(const uint64_t* p) { return Lane256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+    void store(uint64_t* p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    friend Lane256 operator&(Lane256 a, Lane256 b) { return Lane256(_mm256_and_si256(a.v, b.v)); }
+    friend Lane256 operator|(Lane256 a, Lane256 b) { return Lane256(_mm256_or_si256(a.v, b.v)); }
+    friend Lane256 operator^(Lane256 a, Lane256 b) { return Lane256(_mm256_xor_si256(a.v, b.v)); }
+    friend Lane256 operator<<(Lane256 a, int n) { return Lane256(_mm256_slli_epi64(a.v, n)); }
+    friend Lane256 operator>>(Lane256 a, int n) { return Lane256(_mm256_srli_epi64(a.v, n)); }
+};
+
+} // namespace
+
+void boardTermsAvx2(const uint64_t* own, const uint64_t* opp, int count, BoardTerms& out) {
+    boardTermsKernel<Lane256>(own, opp, count, out);
+}
+
+} // namespace OthelloEngine
+#endif
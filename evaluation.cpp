@@ -0,0 +1,345 @@
+#include "evaluation.h"
+#include "eval_kernels.h"
+#include <cstddef>
+#include <fstream>
+#include <vector>
+#if defined(_MSC_VER) && !defined(__clang__) && defined(OTHELLO_HAS_AVX2_KERNEL)
+#include <immintrin.h>  // _xgetbv
+#endif
+
+namespace OthelloEngine {
+
+const int POSITION_WEIGHTS[NUM_SQUARES] = {
+    100, -20, 10, 5, 5, 10, -20, 100,
+    -20, -30, -5, -5, -5, -5, -30, -20,
+    10, -5, 1, 1, 1, 1, -5, 10,
+    5, -5, 1, 1, 1, 1, -5, 5,
+    5, -5, 1, 1, 1, 1, -5, 5,
+    10, -5, 1, 1, 1, 1, -5, 10,
+    -20, -30, -5, -5, -5, -5, -30, -20,
+    100, -20, 10, 5, 5, 10, -20, 100
+};
+
+namespace {
+
+// Pattern tables, laid out one after another inside a phase; the weight file uses the same order.
+const int EDGE_SIZE = 6561;        // 3^8: row 0, cols 0..7
+const int CORNER3_SIZE = 19683;    // 3^9: rows 0..2 x cols 0..2, digit = row * 3 + col
+const int CORNER2X5_SIZE = 59049;  // 3^10: rows 0..1 x cols 0..4, digit = row * 5 + col
+const int DIAG_SIZE = 6561;        // 3^8: squares (i, i)
+const int EDGE_OFFSET = 0;
+const int CORNER3_OFFSET = EDGE_OFFSET + EDGE_SIZE;
+const int CORNER2X5_OFFSET = CORNER3_OFFSET + CORNER3_SIZE;
+const int DIAG_OFFSET = CORNER2X5_OFFSET + CORNER2X5_SIZE;
+const int MOBILITY_OFFSET = DIAG_OFFSET + DIAG_SIZE;
+const int POTENTIAL_OFFSET = MOBILITY_OFFSET + 1;
+const int PHASE_SIZE = POTENTIAL_OFFSET + 1;
+
+// Weight file: "OTEW", uint16 version, uint16 phase count, uint32 weights per phase, then
+// EVAL_PHASES * PHASE_SIZE int16 weights, phase-major. All integers little-endian.
+const char WEIGHT_MAGIC[4] = {'O', 'T', 'E', 'W'};
+const int WEIGHT_VERSION = 1;
+
+const uint64_t COL_0 = 0x0101010101010101ULL;
+const uint64_t NOT_COL_0 = ~COL_0;
+const uint64_t NOT_COL_7 = ~(COL_0 << 7);
+const uint64_t MAIN_DIAGONAL = 0x8040201008040201ULL;
+const uint64_t ANTI_DIAGONAL = 0x0102040810204080ULL;
+
+// Base-3 value of an 8-bit row: bit i becomes digit i (forward) or digit 7 - i (reversed).
+struct Base3Table {
+    int forward[256], reversed[256];
+    Base3Table() {
+        for (int b = 0; b < 256; ++b) {
+            forward[b] = reversed[b] = 0;
+            for (int i = 7; i >= 0; --i) {
+                forward[b] = forward[b] * 3 + ((b >> i) & 1);
+                reversed[b] = reversed[b] * 3 + ((b >> (7 - i)) & 1);
+            }
+        }
+    }
+};
+const Base3Table BASE3;
+
+// Squares (i, i), and (7 - c, c), gathered into bit i / bit c.
+inline int diagonalBits(uint64_t b) { return static_cast<int>(((b & MAIN_DIAGONAL) * COL_0) >> 56); }
+inline int antiDiagonalBits(uint64_t b) { return static_cast<int>(((b & ANTI_DIAGONAL) * COL_0) >> 56); }
+
+inline uint64_t neighbours(uint64_t b) {
+    uint64_t h = ((b << 1) & NOT_COL_0) | ((b >> 1) & NOT_COL_7);
+    uint64_t row = b | h;
+    return h | (row << 8) | (row >> 8);
+}
+
+inline int phaseOf(uint64_t occupied) { return (popCount(occupied) - 4) * EVAL_PHASES / 61; }
+
+// Built-in weights: hand-set pattern features (edge stability, X/C squares next to an empty corner,
+// walls under empty edges, X squares that hand over a corner), scaled by phase. Every entry is
+// feature(own) - feature(opponent), so the tables are colour-symmetric by construction.
+struct FeatureWeights {
+    int corner, xSquare, cSquare, edgeStable, aSquare, bSquare, inner, wall, xDanger, mobility, potential;
+};
+
+FeatureWeights phaseFeatures(int phase) {
+    double t = double(phase) / (EVAL_PHASES - 1);  // 0 = opening, 1 = last moves
+    auto lerp = [t](double a, double b) { return static_cast<int>(a + (b - a) * t + 0.5); };
+    return FeatureWeights{lerp(110, 80), lerp(45, 10), lerp(25, 5), lerp(10, 25), lerp(10, 3), lerp(5, 2),
+                          lerp(5, 0), lerp(6, 1), lerp(35, 15), lerp(9, 6), lerp(4, 1)};
+}
+
+void decode(int index, int digits, int* cells) {
+    for (int i = 0; i < digits; ++i) { cells[i] = index % 3; index /= 3; }
+}
+
+int edgeFeature(const int* c, int me, const FeatureWeights& f) {
+    int v = 0;
+    bool full = true;
+    for (int i = 0; i < 8; ++i) if (!c[i]) full = false;
+    // corners themselves are scored by the 3x3 pattern
+    if (full) {
+        for (int i = 1; i < 7; ++i) if (c[i] == me) v += f.edgeStable;
+    } else {
+        if (c[0] == me) for (int i = 1; i < 7 && c[i] == me; ++i) v += f.edgeStable;
+        if (c[7] == me) for (int i = 6; i > 0 && c[i] == me; --i) v += f.edgeStable;
+    }
+    if (!c[0] && c[1] == me) v -= f.cSquare;
+    if (!c[7] && c[6] == me) v -= f.cSquare;
+    if (c[2] == me) v += f.aSquare;
+    if (c[5] == me) v += f.aSquare;
+    if (c[3] == me) v += f.bSquare;
+    if (c[4] == me) v += f.bSquare;
+    return v;
+}
+
+int corner3Feature(const int* c, int me, const FeatureWeights& f) {
+    int v = 0;
+    if (c[0] == me) v += f.corner;
+    if (!c[0] && c[4] == me) v -= f.xSquare;
+    if (c[5] == me) v -= f.inner;
+    if (c[7] == me) v -= f.inner;
+    return v;
+}
+
+int corner2x5Feature(const int* c, int me, const FeatureWeights& f) {
+    int v = 0;
+    for (int col = 1; col < 5; ++col) if (c[5 + col] == me && !c[col]) v -= f.wall;
+    return v;
+}
+
+int diagonalFeature(const int* c, int me, const FeatureWeights& f) {
+    int v = 0, opp = 3 - me;
+    if (!c[0] && c[1] == me) {
+        int i = 2;
+        while (i < 8 && c[i] == me) ++i;
+        if (i < 8 && c[i] == opp) v -= f.xDanger;
+    }
+    if (!c[7] && c[6] == me) {
+        int i = 5;
+        while (i >= 0 && c[i] == me) --i;
+        if (i >= 0 && c[i] == opp) v -= f.xDanger;
+    }
+    return v;
+}
+
+void fillPattern(int16_t* table, int size, int digits, int (*feature)(const int*, int, const FeatureWeights&),
+                 const FeatureWeights& f) {
+    int cells[10];
+    for (int index = 0; index < size; ++index) {
+        decode(index, digits, cells);
+        table[index] = static_cast<int16_t>(feature(cells, 1, f) - feature(cells, 2, f));
+    }
+}
+
+std::vector<int16_t> defaultWeights() {
+    std::vector<int16_t> w(static_cast<std::size_t>(EVAL_PHASES) * PHASE_SIZE);
+    for (int phase = 0; phase < EVAL_PHASES; ++phase) {
+        int16_t* p = &w[static_cast<std::size_t>(phase) * PHASE_SIZE];
+        FeatureWeights f = phaseFeatures(phase);
+        fillPattern(p + EDGE_OFFSET, EDGE_SIZE, 8, edgeFeature, f);
+        fillPattern(p + CORNER3_OFFSET, CORNER3_SIZE, 9, corner3Feature, f);
+        fillPattern(p + CORNER2X5_OFFSET, CORNER2X5_SIZE, 10, corner2x5Feature, f);
+        fillPattern(p + DIAG_OFFSET, DIAG_SIZE, 8, diagonalFeature, f);
+        p[MOBILITY_OFFSET] = static_cast<int16_t>(f.mobility);
+        p[POTENTIAL_OFFSET] = static_cast<int16_t>(f.potential);
+    }
+    return w;
+}
+
+std::vector<int16_t>& weights() {
+    static std::vector<int16_t> w = defaultWeights();
+    return w;
+}
+
+unsigned readLE(const unsigned char* p, int bytes) {
+    unsigned v = 0;
+    for (int i = bytes - 1; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+void writeLE(std::ostream& out, unsigned v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.put(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+const int16_t* phaseWeights(uint64_t occupied) {
+    return &weights()[static_cast<std::size_t>(phaseOf(occupied)) * PHASE_SIZE];
+}
+
+// Sum of the pattern tables for one position; tOwn / tOpp are the transposed boards.
+int patternScore(uint64_t own, uint64_t opp, uint64_t tOwn, uint64_t tOpp, const int16_t* w) {
+    const int16_t* edge = w + EDGE_OFFSET;
+    const int16_t* corner3 = w + CORNER3_OFFSET;
+    const int16_t* corner2x5 = w + CORNER2X5_OFFSET;
+
+    // Each symmetry that brings a corner/orientation to (0, 0) is read straight from the rows of
+    // the board or of its transpose: flipping walks rows bottom-up, mirroring reads a row reversed
+    // (high bits through the reversed table).
+    uint8_t r[8], q[8], tr[8], tq[8];  // own / opp rows, own / opp columns
+    for (int i = 0; i < 8; ++i) {
+        r[i] = static_cast<uint8_t>(own >> (8 * i));   q[i] = static_cast<uint8_t>(opp >> (8 * i));
+        tr[i] = static_cast<uint8_t>(tOwn >> (8 * i)); tq[i] = static_cast<uint8_t>(tOpp >> (8 * i));
+    }
+    const int* fwd = BASE3.forward;
+    const int* rev = BASE3.reversed;
+    auto F = [fwd](int o, int p, int mask) { return fwd[o & mask] + 2 * fwd[p & mask]; };
+    auto R = [rev](int o, int p, int mask) { return rev[o & mask] + 2 * rev[p & mask]; };
+
+    int score = edge[F(r[0], q[0], 0xFF)] + edge[F(r[7], q[7], 0xFF)] + edge[F(tr[0], tq[0], 0xFF)] + edge[F(tr[7], tq[7], 0xFF)];
+
+    score += corner3[F(r[0], q[0], 0x07) + 27 * F(r[1], q[1], 0x07) + 729 * F(r[2], q[2], 0x07)];
+    score += corner3[R(r[0], q[0], 0xE0) + 27 * R(r[1], q[1], 0xE0) + 729 * R(r[2], q[2], 0xE0)];
+    score += corner3[F(r[7], q[7], 0x07) + 27 * F(r[6], q[6], 0x07) + 729 * F(r[5], q[5], 0x07)];
+    score += corner3[R(r[7], q[7], 0xE0) + 27 * R(r[6], q[6], 0xE0) + 729 * R(r[5], q[5], 0xE0)];
+
+    score += corner2x5[F(r[0], q[0], 0x1F) + 243 * F(r[1], q[1], 0x1F)];
+    score += corner2x5[R(r[0], q[0], 0xF8) + 243 * R(r[1], q[1], 0xF8)];
+    score += corner2x5[F(r[7], q[7], 0x1F) + 243 * F(r[6], q[6], 0x1F)];
+    score += corner2x5[R(r[7], q[7], 0xF8) + 243 * R(r[6], q[6], 0xF8)];
+    score += corner2x5[F(tr[0], tq[0], 0x1F) + 243 * F(tr[1], tq[1], 0x1F)];
+    score += corner2x5[R(tr[0], tq[0], 0xF8) + 243 * R(tr[1], tq[1], 0xF8)];
+    score += corner2x5[F(tr[7], tq[7], 0x1F) + 243 * F(tr[6], tq[6], 0x1F)];
+    score += corner2x5[R(tr[7], tq[7], 0xF8) + 243 * R(tr[6], tq[6], 0xF8)];
+
+    score += w[DIAG_OFFSET + F(diagonalBits(own), diagonalBits(opp), 0xFF)];
+    score += w[DIAG_OFFSET + R(antiDiagonalBits(own), antiDiagonalBits(opp), 0xFF)];
+    return score;
+}
+
+inline int mobilityScore(uint64_t ownMoves, uint64_t oppMoves, uint64_t ownFrontier, uint64_t oppFrontier, const int16_t* w) {
+    return (popCount(ownMoves) - popCount(oppMoves)) * w[MOBILITY_OFFSET]
+         + (popCount(ownFrontier) - popCount(oppFrontier)) * w[POTENTIAL_OFFSET];
+}
+
+bool cpuHasAvx2() {
+#if !defined(OTHELLO_HAS_AVX2_KERNEL)
+    return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7) return false;
+    __cpuid(r, 1);
+    bool osxsave = (r[2] >> 27) & 1, avx = (r[2] >> 28) & 1;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;  // OS must save the YMM registers
+    __cpuidex(r, 7, 0);
+    return (r[1] >> 5) & 1;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+BoardTermsFn kernelFunction(EvalKernel kernel) {
+    switch (kernel) {
+#if defined(OTHELLO_HAS_AVX2_KERNEL)
+    case EvalKernel::AVX2: return boardTermsAvx2;
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+    case EvalKernel::SSE2: return boardTermsSse2;
+#endif
+    default: return boardTermsScalar;
+    }
+}
+
+} // namespace
+
+int evaluate(const Position& pos, Color side) {
+    uint64_t own = pos.discs[side], opp = pos.discs[opponentOf(side)];
+    uint64_t ownMoves = legalMoves(own, opp), oppMoves = legalMoves(opp, own);
+    if (!ownMoves && !oppMoves) return finalScore(pos, side);
+
+    const int16_t* w = phaseWeights(own | opp);
+    uint64_t empty = ~(own | opp);
+    return patternScore(own, opp, flipDiagonal(own), flipDiagonal(opp), w)
+         + mobilityScore(ownMoves, oppMoves, neighbours(opp) & empty, neighbours(own) & empty, w);
+}
+
+bool evalKernelSupported(EvalKernel kernel) {
+    switch (kernel) {
+    case EvalKernel::AVX2: { static const bool avx2 = cpuHasAvx2(); return avx2; }
+#if defined(__x86_64__) || defined(_M_X64)
+    case EvalKernel::SSE2: return true;
+#endif
+    case EvalKernel::SCALAR: return true;
+    default: return false;
+    }
+}
+
+EvalKernel bestEvalKernel() {
+    static const EvalKernel best = evalKernelSupported(EvalKernel::AVX2) ? EvalKernel::AVX2
+                                 : evalKernelSupported(EvalKernel::SSE2) ? EvalKernel::SSE2 : EvalKernel::SCALAR;
+    return best;
+}
+
+const char* evalKernelName(EvalKernel kernel) {
+    return kernel == EvalKernel::AVX2 ? "avx2" : kernel == EvalKernel::SSE2 ? "sse2" : "scalar";
+}
+
+void evaluateBatch(const uint64_t* own, const uint64_t* opp, int count, int* scores) {
+    evaluateBatch(own, opp, count, scores, bestEvalKernel());
+}
+
+void evaluateBatch(const uint64_t* own, const uint64_t* opp, int count, int* scores, EvalKernel kernel) {
+    BoardTermsFn boardTerms = kernelFunction(kernel);
+    BoardTerms t;
+    for (int base = 0; base < count; base += EVAL_BATCH) {
+        int n = count - base < EVAL_BATCH ? count - base : EVAL_BATCH;
+        boardTerms(own + base, opp + base, n, t);
+        for (int i = 0; i < n; ++i) {
+            uint64_t o = own[base + i], p = opp[base + i];
+            if (!t.ownMoves[i] && !t.oppMoves[i]) { scores[base + i] = (popCount(o) - popCount(p)) * DISC_SCORE; continue; }
+            const int16_t* w = phaseWeights(o | p);
+            scores[base + i] = patternScore(o, p, t.tOwn[i], t.tOpp[i], w)
+                             + mobilityScore(t.ownMoves[i], t.oppMoves[i], t.ownFrontier[i], t.oppFrontier[i], w);
+        }
+    }
+}
+
+bool loadEvalWeights(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    unsigned char header[12];
+    if (!in.read(reinterpret_cast<char*>(header), sizeof header)) return false;
+    for (int i = 0; i < 4; ++i) if (header[i] != static_cast<unsigned char>(WEIGHT_MAGIC[i])) return false;
+    if (readLE(header + 4, 2) != WEIGHT_VERSION || readLE(header + 6, 2) != EVAL_PHASES ||
+        readLE(header + 8, 4) != static_cast<unsigned>(PHASE_SIZE))
+        return false;
+
+    std::vector<unsigned char> raw(static_cast<std::size_t>(EVAL_PHASES) * PHASE_SIZE * 2);
+    if (!in.read(reinterpret_cast<char*>(raw.data()), static_cast<std::streamsize>(raw.size()))) return false;
+    std::vector<int16_t> w(raw.size() / 2);
+    for (std::size_t i = 0; i < w.size(); ++i) w[i] = static_cast<int16_t>(readLE(&raw[2 * i], 2));
+    weights().swap(w);
+    return true;
+}
+
+bool saveEvalWeights(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    out.write(WEIGHT_MAGIC, 4);
+    writeLE(out, WEIGHT_VERSION, 2);
+    writeLE(out, EVAL_PHASES, 2);
+    writeLE(out, PHASE_SIZE, 4);
+    for (int16_t v : weights()) writeLE(out, static_cast<uint16_t>(v), 2);
+    return static_cast<bool>(out);
+}
+
+} // namespace OthelloEngine
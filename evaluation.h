@@ -0,0 +1,54 @@
+#ifndef EVALUATION_H
+#define EVALUATION_H
+#include <string>
+
+#include "bitboard.h"
+
+namespace OthelloEngine {
+
+const int SCORE_INF = 1000000;
+const int DISC_SCORE = 1000;  // one disc of final margin, dominates any heuristic score
+
+// Static square weights (corners high, X/C squares negative); used for move ordering.
+extern const int POSITION_WEIGHTS[NUM_SQUARES];
+
+// Static evaluation from `side`'s point of view. Edges, 3x3 corners, 2x5 corners and the two
+// main diagonals are read as base-3 pattern indexes (0 empty, 1 own, 2 opponent) into weight
+// tables, each instance under the board symmetry that maps it onto one shared table; mobility
+// and potential mobility are added on top. Every term has separate weights per game phase
+// (EVAL_PHASES buckets of disc count). A finished game (neither side can move) scores as finalScore.
+int evaluate(const Position& pos, Color side);
+
+const int EVAL_PHASES = 8;
+
+// Batch evaluation, e.g. all children of a node in one call. The board-wide terms (both mobility
+// fills, the frontier masks, the transposed boards the pattern indexes read) run several positions
+// per SIMD register; the table lookups stay per position. Kernels: AVX2 (4 positions per register,
+// used when both the build and the CPU have it), SSE2 (2 per register, any x86-64), scalar.
+enum class EvalKernel { SCALAR, SSE2, AVX2 };
+
+// AVX2 if available, then SSE2, then scalar; CPU detection runs once.
+EvalKernel bestEvalKernel();
+bool evalKernelSupported(EvalKernel kernel);
+const char* evalKernelName(EvalKernel kernel);
+
+// Scores `count` positions, each from the point of view of the side owning own[i]; the results
+// equal evaluate() of the same positions. The kernel overload requires evalKernelSupported(kernel).
+void evaluateBatch(const uint64_t* own, const uint64_t* opp, int count, int* scores);
+void evaluateBatch(const uint64_t* own, const uint64_t* opp, int count, int* scores, EvalKernel kernel);
+
+// Replaces the built-in weights with a weight file (format in evaluation.cpp). Returns false and
+// keeps the current weights if the file is missing or malformed. Not thread-safe: call it before
+// any search starts.
+bool loadEvalWeights(const std::string& path);
+// Writes the weights currently in use, e.g. to seed a tuning run from the built-in defaults.
+bool saveEvalWeights(const std::string& path);
+
+// Score of a finished game from `side`'s point of view (disc margin * DISC_SCORE).
+inline int finalScore(const Position& pos, Color side) {
+    return (pos.count(side) - pos.count(opponentOf(side))) * DISC_SCORE;
+}
+
+} // namespace OthelloEngine
+
+#endif
@@ -0,0 +1,129 @@
+#include "game_record.h"
+#include <cstring>
+
+#include "bitboard.h"
+
+// Record file format:
+//   header, 5 bytes: "OTGR", uint8 version = 1
+//   records, back to back:
+//     varint body length, then the body:
+//       varint flags (bit 0: finished), varint zigzag(black - white margin),
+//       varint metadata length, metadata bytes, then one byte per move up to the end of the body
+//       (square 0..63, 64 = pass)
+// Varints are unsigned LEB128: 7 bits per byte, low bits first, high bit set on all but the last.
+// A 60-move game without metadata takes 64 bytes.
+
+namespace OthelloEngine {
+
+namespace {
+
+const char RECORD_MAGIC[4] = {'O', 'T', 'G', 'R'};
+const uint8_t RECORD_VERSION = 1;
+const size_t RECORD_HEADER = 5;
+
+void putVarint(std::string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out += static_cast<char>(v | 0x80);
+        v >>= 7;
+    }
+    out += static_cast<char>(v);
+}
+
+// Reads a varint from [p, end); false if it runs past the end or beyond 64 bits.
+bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t b = *p++;
+        v |= uint64_t(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+bool GameRecordWriter::open(const std::string& path, bool append) {
+    close();
+    out.open(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+    if (!out) return false;
+    out.seekp(0, std::ios::end);
+    if (out.tellp() == std::streampos(0)) {
+        out.write(RECORD_MAGIC, 4);
+        out.put(static_cast<char>(RECORD_VERSION));
+    }
+    return static_cast<bool>(out);
+}
+
+bool GameRecordWriter::close() {
+    if (!out.is_open()) return true;
+    out.close();
+    return !out.fail();
+}
+
+bool GameRecordWriter::write(const std::vector<int>& moves, bool finished, int margin, const std::string& meta) {
+    std::string body;
+    putVarint(body, finished ? 1 : 0);
+    putVarint(body, margin < 0 ? (uint64_t(-int64_t(margin)) << 1) - 1 : uint64_t(margin) << 1);
+    putVarint(body, meta.size());
+    body += meta;
+    for (int m : moves) body += static_cast<char>(m < 0 ? RECORD_PASS : m);
+    buffer.clear();
+    putVarint(buffer, body.size());
+    buffer += body;
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(out);
+}
+
+bool GameRecordReader::open(const std::string& path) {
+    close();
+    if (!file.open(path)) return false;
+    if (file.size() < RECORD_HEADER || std::memcmp(file.data(), RECORD_MAGIC, 4) != 0 || file.data()[4] != RECORD_VERSION) {
+        close();
+        return false;
+    }
+    pos = RECORD_HEADER;
+    return true;
+}
+
+void GameRecordReader::close() {
+    file.close();
+    pos = 0;
+    bad = false;
+}
+
+bool GameRecordReader::next(GameRecord& game) {
+    if (bad || !file.isOpen() || pos >= file.size()) return false;
+    const uint8_t* p = file.data() + pos;
+    const uint8_t* end = file.data() + file.size();
+    uint64_t length, flags, zigzag, metaLength;
+    bad = true;
+    if (pos < RECORD_HEADER || !getVarint(p, end, length) || length > uint64_t(end - p)) return false;
+    end = p + length;
+    if (!getVarint(p, end, flags) || !getVarint(p, end, zigzag) || !getVarint(p, end, metaLength)
+        || metaLength > uint64_t(end - p))
+        return false;
+    game.offset = pos;
+    game.finished = flags & 1;
+    game.margin = static_cast<int>(zigzag & 1 ? -static_cast<int64_t>((zigzag + 1) >> 1) : static_cast<int64_t>(zigzag >> 1));
+    game.meta = reinterpret_cast<const char*>(p);
+    game.metaLength = static_cast<size_t>(metaLength);
+    game.moves = p + metaLength;
+    game.moveCount = static_cast<size_t>(end - game.moves);
+    for (size_t i = 0; i < game.moveCount; ++i) {
+        if (game.moves[i] > RECORD_PASS) return false;
+    }
+    bad = false;
+    pos = static_cast<size_t>(end - file.data());
+    return true;
+}
+
+std::string gameRecordText(const GameRecord& game) {
+    std::string text;
+    text.reserve(2 * game.moveCount);
+    for (size_t i = 0; i < game.moveCount; ++i) {
+        if (game.moves[i] != RECORD_PASS) text += squareName(game.moves[i]);
+    }
+    return text;
+}
+
+} // namespace OthelloEngine
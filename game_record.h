@@ -0,0 +1,71 @@
+#ifndef GAME_RECORD_H
+#define GAME_RECORD_H
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "mapped_file.h"
+
+namespace OthelloEngine {
+
+const int RECORD_PASS = 64;  // move byte of a pass
+
+// One game as stored in a record file (format in game_record.cpp). The pointers refer to the
+// reader's mapping and stay valid until the reader is closed.
+struct GameRecord {
+    size_t offset = 0;             // of the record in the file
+    const uint8_t* moves = nullptr;  // squares in play order, RECORD_PASS for a pass
+    size_t moveCount = 0;
+    bool finished = false;         // played to the end; margin is then final
+    int margin = 0;                // black discs - white discs on the last board
+    const char* meta = nullptr;    // free-form text, e.g. the engines that played
+    size_t metaLength = 0;
+
+    std::string metadata() const { return std::string(meta, metaLength); }
+};
+
+// Appends games to a record file, one compact record per write(); the header is written when the
+// file is new or empty.
+class GameRecordWriter {
+public:
+    bool open(const std::string& path, bool append = false);
+    bool close();
+    bool isOpen() const { return out.is_open(); }
+
+    // `moves` are squares, -1 for a pass.
+    bool write(const std::vector<int>& moves, bool finished, int margin, const std::string& meta = std::string());
+
+private:
+    std::ofstream out;
+    std::string buffer;
+};
+
+// Zero-copy sequential reader over a memory-mapped record file.
+class GameRecordReader {
+public:
+    // False if the file is missing or does not start with the record header.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    // Next record; false at the end of the file or at a malformed record (corrupt() is then set).
+    bool next(GameRecord& game);
+    bool corrupt() const { return bad; }
+    // Byte offset of the next record; seek() takes an offset a record starts at, e.g. a
+    // GameRecord::offset seen earlier.
+    size_t offset() const { return pos; }
+    void seek(size_t offset) { pos = offset; bad = false; }
+
+private:
+    MappedFile file;
+    size_t pos = 0;
+    bool bad = false;
+};
+
+// The moves as concatenated squares ("f5d6c3..."), passes omitted: the text corpus format.
+std::string gameRecordText(const GameRecord& game);
+
+} // namespace OthelloEngine
+
+#endif
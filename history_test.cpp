@@ -0,0 +1,100 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bitboard.h"
+#include "move_history.h"
+
+// MoveHistory tests, no SFML dependency; run by ctest.
+
+using namespace OthelloEngine;
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cerr << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+// Random legal game that fills the board, so the history holds exactly MAX_MOVES moves.
+// `boards[i]` is the board after i moves.
+void playFullGame(MoveHistory& history, std::vector<Position>& boards) {
+    for (unsigned seed = 1;; ++seed) {
+        std::mt19937 rng(seed);
+        Position pos = Position::initial();
+        Color side = BLACK;
+        history.clear();
+        boards.assign(1, pos);
+        for (;;) {
+            if (!pos.legalMoves(side)) side = opponentOf(side);
+            MoveList moves(pos.legalMoves(side));
+            if (moves.empty()) break;
+            int sq = moves[std::uniform_int_distribution<int>(0, moves.size - 1)(rng)];
+            history.push(side, sq, pos.makeMove(side, sq));
+            boards.push_back(pos);
+            side = opponentOf(side);
+        }
+        if (pos.emptyCount() == 0) return;
+    }
+}
+
+void testLimits() {
+    MoveHistory history;
+    std::vector<Position> boards;
+    playFullGame(history, boards);
+    Position pos = boards.back();
+    check(history.size() == MoveHistory::MAX_MOVES && history.ply() == MoveHistory::MAX_MOVES, "full game recorded");
+    check(!history.canRedo() && history.canUndo(), "full game: undo only");
+
+    // a push past the capacity is dropped instead of writing out of bounds
+    history.push(BLACK, 0, 0);
+    check(history.size() == MoveHistory::MAX_MOVES, "push at capacity ignored");
+
+    bool same = true;
+    for (int ply = MoveHistory::MAX_MOVES; ply > 0; --ply) {
+        Color mover = history.undo(pos);
+        same = same && pos == boards[ply - 1] && mover == static_cast<Color>(history[ply - 1].side);
+    }
+    check(same && history.ply() == 0 && !history.canUndo(), "undo back to the start");
+    check(history.sideToMove(pos) == BLACK, "black moves first");
+
+    same = true;
+    for (int ply = 1; ply <= MoveHistory::MAX_MOVES; ++ply) {
+        history.redo(pos);
+        same = same && pos == boards[ply];
+    }
+    check(same && !history.canRedo(), "redo to the end");
+
+    history.jumpTo(pos, 30);
+    check(history.ply() == 30 && pos == boards[30], "jump back to ply 30");
+    history.jumpTo(pos, MoveHistory::MAX_MOVES + 10);
+    check(history.ply() == MoveHistory::MAX_MOVES && pos == boards.back(), "jump past the end clamps");
+    history.jumpTo(pos, -1);
+    check(history.ply() == 0 && pos == Position::initial(), "jump before the start clamps");
+    history.jumpTo(pos, MoveHistory::MAX_MOVES);
+    check(history.sideToMove(pos) == opponentOf(static_cast<Color>(history[MoveHistory::MAX_MOVES - 1].side)),
+          "side to move after the last move");
+
+    // a new move after undoing drops the redo tail
+    history.jumpTo(pos, 10);
+    Color side = history.sideToMove(pos);
+    MoveList moves(pos.legalMoves(side));
+    history.push(side, moves[0], pos.makeMove(side, moves[0]));
+    check(history.size() == 11 && history.ply() == 11 && !history.canRedo(), "push after undo drops the redo tail");
+    history.undo(pos);
+    check(pos == boards[10], "undo the replacing move");
+}
+
+} // namespace
+
+int main() {
+    testLimits();
+    if (failures) return 1;
+    std::cout << "all tests passed\n";
+    return 0;
+}
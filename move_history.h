@@ -0,0 +1,73 @@
+#ifndef MOVE_HISTORY_H
+#define MOVE_HISTORY_H
+#include <cstdint>
+
+#include "bitboard.h"
+
+namespace OthelloEngine {
+
+// Undo / redo history of one game, shared by the console game and the GUI. Each move is kept as
+// (square, flip mask, mover) in a fixed array: every move fills a square, so a game never has more
+// than MAX_MOVES of them, and passes need no entry because undo restores the mover as the side to
+// move. Undo and redo unmake / remake one move from its flip mask in O(1); jumpTo walks the board
+// to any recorded ply for review. Recording a move while some were undone drops the redo tail.
+class MoveHistory {
+public:
+    static const int MAX_MOVES = NUM_SQUARES - 4;
+
+    struct Move {
+        uint64_t flips;
+        int8_t square;
+        uint8_t side;  // Color that played it
+    };
+
+    void clear() { length = cursor = 0; }
+    // Records a move just made on the board.
+    void push(Color side, int square, uint64_t flips) {
+        if (cursor == MAX_MOVES) return;  // unreachable in a legal game
+        moves[cursor++] = Move{flips, static_cast<int8_t>(square), static_cast<uint8_t>(side)};
+        length = cursor;
+    }
+
+    int ply() const { return cursor; }    // moves currently on the board
+    int size() const { return length; }   // moves recorded, including undone ones
+    bool canUndo() const { return cursor > 0; }
+    bool canRedo() const { return cursor < length; }
+    const Move& operator[](int i) const { return moves[i]; }
+
+    // Unmakes the last move on `pos`; returns its mover, who is to move again. Needs canUndo().
+    Color undo(Position& pos) {
+        const Move& m = moves[--cursor];
+        pos.undoMove(static_cast<Color>(m.side), m.square, m.flips);
+        return static_cast<Color>(m.side);
+    }
+    // Remakes the next undone move on `pos`; returns its mover. Needs canRedo().
+    Color redo(Position& pos) {
+        const Move& m = moves[cursor++];
+        pos.applyMove(static_cast<Color>(m.side), m.square, m.flips);
+        return static_cast<Color>(m.side);
+    }
+    // Undoes or redoes to `target` moves on the board (clamped to [0, size()]).
+    void jumpTo(Position& pos, int target) {
+        while (cursor > target && canUndo()) undo(pos);
+        while (cursor < target && canRedo()) redo(pos);
+    }
+
+    // Side to move on `pos` at the current ply: the mover of the next recorded move if there is
+    // one, otherwise the opponent of the last mover unless that side has to pass.
+    Color sideToMove(const Position& pos) const {
+        if (cursor < length) return static_cast<Color>(moves[cursor].side);
+        if (cursor == 0) return BLACK;
+        Color side = opponentOf(static_cast<Color>(moves[cursor - 1].side));
+        if (!pos.legalMoves(side) && pos.legalMoves(opponentOf(side))) side = opponentOf(side);
+        return side;
+    }
+
+private:
+    Move moves[MAX_MOVES];
+    int length = 0, cursor = 0;
+};
+
+} // namespace OthelloEngine
+
+#endif
@@ -0,0 +1,232 @@
+#include "opening_book.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+// Book file format, little-endian; records are read in place, which assumes a little-endian host.
+//   header, 32 bytes: "OTBK", uint16 version = 1, uint16 reserved, uint32 position count,
+//                     uint32 move count, uint32 max plies, 12 reserved bytes
+//   positions, 32 bytes each, sorted by key then board: uint64 key, uint64 own, uint64 opp
+//                     (canonicalize()d, side to move first), uint32 first move, uint16 move count,
+//                     uint16 reserved
+//   moves, 12 bytes each, per position most played first: uint8 square (on the normalized board),
+//                     3 reserved bytes, uint32 games, uint32 points
+// key = bookKey(own, opp); its formula is part of the format.
+
+namespace OthelloEngine {
+
+struct BookPosition {
+    uint64_t key, own, opp;
+    uint32_t firstMove;
+    uint16_t moveCount, reserved;
+};
+
+namespace {
+
+struct BookHeader {
+    char magic[4];
+    uint16_t version, reserved;
+    uint32_t positions, moves, maxPlies;
+    uint8_t pad[12];
+};
+
+struct BookMoveRecord {
+    uint8_t square, reserved[3];
+    uint32_t games, points;
+};
+
+static_assert(sizeof(BookHeader) == 32, "book header layout");
+static_assert(sizeof(BookPosition) == 32, "book position layout");
+static_assert(sizeof(BookMoveRecord) == 12, "book move layout");
+
+const char BOOK_MAGIC[4] = {'O', 'T', 'B', 'K'};
+const uint16_t BOOK_VERSION = 1;
+
+uint64_t bookKey(uint64_t own, uint64_t opp) {
+    uint64_t h = own * 0x9E3779B97F4A7C15ULL ^ (opp + 0x632BE59BD9B4E019ULL) * 0xC2B2AE3D27D4EB4FULL;
+    return h ^ (h >> 29);
+}
+
+// The normalized move among the images of `sq` under every symmetry that maps the position onto its
+// canonical form, so equivalent moves of a symmetric position share one record.
+int canonicalSquare(uint64_t own, uint64_t opp, uint64_t cOwn, uint64_t cOpp, int sq) {
+    int best = NUM_SQUARES;
+    for (int sym = 0; sym < NUM_SYMMETRIES; ++sym) {
+        if (transformBoard(own, sym) == cOwn && transformBoard(opp, sym) == cOpp)
+            best = std::min(best, transformSquare(sq, sym));
+    }
+    return best;
+}
+
+} // namespace
+
+bool OpeningBook::open(const std::string& path) {
+    close();
+    if (!file.open(path)) return false;
+    const unsigned char* data = file.data();
+    size_t size = file.size();
+    BookHeader header;
+    bool ok = size >= sizeof(header);
+    if (ok) {
+        std::memcpy(&header, data, sizeof(header));
+        ok = std::memcmp(header.magic, BOOK_MAGIC, 4) == 0 && header.version == BOOK_VERSION
+             && size == sizeof(header) + header.positions * sizeof(BookPosition) + header.moves * sizeof(BookMoveRecord);
+    }
+    if (ok) {
+        // every position's move range must lie inside the move table, so lookup never reads past the map
+        const BookPosition* entries = reinterpret_cast<const BookPosition*>(data + sizeof(header));
+        for (uint32_t i = 0; ok && i < header.positions; ++i)
+            ok = entries[i].firstMove <= header.moves && entries[i].moveCount <= header.moves - entries[i].firstMove;
+        const BookMoveRecord* moves = reinterpret_cast<const BookMoveRecord*>(entries + header.positions);
+        for (uint32_t i = 0; ok && i < header.moves; ++i) ok = moves[i].square < NUM_SQUARES;
+    }
+    if (!ok) { close(); return false; }
+    positions = header.positions;
+    return true;
+}
+
+void OpeningBook::close() {
+    file.close();
+    positions = 0;
+}
+
+const BookPosition* OpeningBook::find(uint64_t own, uint64_t opp) const {
+    const BookPosition* first = reinterpret_cast<const BookPosition*>(file.data() + sizeof(BookHeader));
+    const BookPosition* last = first + positions;
+    uint64_t key = bookKey(own, opp);
+    const BookPosition* it = std::lower_bound(first, last, key, [](const BookPosition& p, uint64_t k) { return p.key < k; });
+    for (; it != last && it->key == key; ++it) {
+        if (it->own == own && it->opp == opp) return it;
+    }
+    return nullptr;
+}
+
+std::vector<BookMove> OpeningBook::lookup(const Position& pos, Color side) const {
+    std::vector<BookMove> out;
+    if (!file.isOpen()) return out;
+    uint64_t own = pos.discs[side], opp = pos.discs[opponentOf(side)];
+    int sym = canonicalize(own, opp);
+    const BookPosition* p = find(own, opp);
+    if (!p) return out;
+    const BookMoveRecord* moves = reinterpret_cast<const BookMoveRecord*>(file.data() + sizeof(BookHeader) + positions * sizeof(BookPosition));
+    for (uint32_t i = 0; i < p->moveCount; ++i) {
+        const BookMoveRecord& m = moves[p->firstMove + i];
+        out.push_back({untransformSquare(m.square, sym), m.games, m.points});
+    }
+    return out;
+}
+
+int OpeningBook::pick(const Position& pos, Color side, std::mt19937& rng) const {
+    std::vector<BookMove> moves = lookup(pos, side);
+    uint64_t total = 0;
+    for (const BookMove& m : moves) total += m.games;
+    if (total == 0) return -1;
+    uint64_t r = std::uniform_int_distribution<uint64_t>(0, total - 1)(rng);
+    for (const BookMove& m : moves) {
+        if (r < m.games) return m.square;
+        r -= m.games;
+    }
+    return moves.back().square;
+}
+
+bool buildOpeningBook(std::istream& games, const std::string& outPath, const BookBuildOptions& options, BookBuildStats* stats) {
+    struct BoardKey {
+        uint64_t own, opp;
+        bool operator==(const BoardKey& o) const { return own == o.own && opp == o.opp; }
+    };
+    struct BoardHash {
+        size_t operator()(const BoardKey& k) const { return static_cast<size_t>(bookKey(k.own, k.opp)); }
+    };
+    struct MoveStats { uint32_t games = 0, points = 0; };
+    std::unordered_map<BoardKey, std::unordered_map<int, MoveStats>, BoardHash> tree;
+    BookBuildStats counts;
+
+    std::string line;
+    std::vector<std::pair<BoardKey, int>> visited;  // normalized position and move, per ply
+    std::vector<Color> movers;
+    while (std::getline(games, line)) {
+        Position pos = Position::initial();
+        Color side = BLACK;
+        visited.clear();
+        movers.clear();
+        bool legal = true;
+        size_t i = 0;
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) ++i;
+        if (i == line.size()) continue;  // blank line
+        for (; i + 1 < line.size() && line[i] != ' ' && line[i] != '\r'; i += 2) {
+            if (!pos.legalMoves(side)) side = opponentOf(side);  // pass
+            int sq = parseSquare(line.c_str() + i);
+            if (sq < 0 || !(pos.legalMoves(side) & squareBit(sq))) { legal = false; break; }
+            if (static_cast<int>(visited.size()) < options.maxPlies) {
+                uint64_t own = pos.discs[side], opp = pos.discs[opponentOf(side)];
+                BoardKey k{own, opp};
+                canonicalize(k.own, k.opp);
+                visited.push_back({k, canonicalSquare(own, opp, k.own, k.opp, sq)});
+                movers.push_back(side);
+            }
+            pos.makeMove(side, sq);
+            side = opponentOf(side);
+        }
+        if (!legal) { ++counts.skipped; continue; }
+        ++counts.games;
+        bool finished = !pos.legalMoves(BLACK) && !pos.legalMoves(WHITE);
+        int margin = pos.count(BLACK) - pos.count(WHITE);
+        for (size_t ply = 0; ply < visited.size(); ++ply) {
+            MoveStats& m = tree[visited[ply].first][visited[ply].second];
+            ++m.games;
+            if (finished) {
+                int own = movers[ply] == BLACK ? margin : -margin;
+                m.points += own > 0 ? 2 : own == 0 ? 1 : 0;
+            }
+        }
+    }
+
+    // flatten: keep moves played often enough, then sort positions by key
+    struct Entry { BookPosition pos; std::vector<BookMoveRecord> moves; };
+    std::vector<Entry> entries;
+    for (const auto& node : tree) {
+        Entry e;
+        uint32_t reached = 0;
+        for (const auto& mv : node.second) {
+            reached += mv.second.games;
+            if (static_cast<int>(mv.second.games) < options.minGames) continue;
+            BookMoveRecord r = {};
+            r.square = static_cast<uint8_t>(mv.first);
+            r.games = mv.second.games;
+            r.points = mv.second.points;
+            e.moves.push_back(r);
+        }
+        if (e.moves.empty() || static_cast<int>(reached) < options.minGames) continue;
+        std::sort(e.moves.begin(), e.moves.end(), [](const BookMoveRecord& a, const BookMoveRecord& b) {
+            return a.games != b.games ? a.games > b.games : a.square < b.square;
+        });
+        e.pos = BookPosition{bookKey(node.first.own, node.first.opp), node.first.own, node.first.opp, 0, static_cast<uint16_t>(e.moves.size()), 0};
+        entries.push_back(std::move(e));
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        if (a.pos.key != b.pos.key) return a.pos.key < b.pos.key;
+        return a.pos.own != b.pos.own ? a.pos.own < b.pos.own : a.pos.opp < b.pos.opp;
+    });
+
+    BookHeader header = {};
+    std::memcpy(header.magic, BOOK_MAGIC, 4);
+    header.version = BOOK_VERSION;
+    header.maxPlies = static_cast<uint32_t>(options.maxPlies);
+    header.positions = static_cast<uint32_t>(entries.size());
+    for (Entry& e : entries) { e.pos.firstMove = header.moves; header.moves += e.pos.moveCount; }
+
+    std::ofstream out(outPath, std::ios::binary);
+    if (!out) return false;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Entry& e : entries) out.write(reinterpret_cast<const char*>(&e.pos), sizeof(e.pos));
+    for (const Entry& e : entries) out.write(reinterpret_cast<const char*>(e.moves.data()), static_cast<std::streamsize>(e.moves.size() * sizeof(BookMoveRecord)));
+    if (!out) return false;
+
+    counts.positions = header.positions;
+    counts.moves = header.moves;
+    if (stats) *stats = counts;
+    return true;
+}
+
+} // namespace OthelloEngine
@@ -0,0 +1,69 @@
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+#include <cstdint>
+#include <istream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bitboard.h"
+#include "mapped_file.h"
+
+namespace OthelloEngine {
+
+struct BookMove {
+    int square;       // on the queried board
+    uint32_t games;   // corpus games that played it here
+    uint32_t points;  // 2 per win + 1 per draw, for the side playing it
+};
+
+// Read-only opening book. The file (format in opening_book.cpp) is memory-mapped and queried in
+// place: positions are stored symmetry-normalized (canonicalize) and sorted by a hash of the
+// normalized board, so a lookup is one binary search with no parsing or allocation at startup.
+// A loaded book is immutable, so one instance can serve any number of threads.
+struct BookPosition;
+
+class OpeningBook {
+public:
+    OpeningBook() = default;
+    ~OpeningBook() { close(); }
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    // Maps the file; false (and no book) if it is missing or malformed.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+    size_t positionCount() const { return positions; }
+
+    // Book moves for `side` to move, most played first; empty if the position is not in the book.
+    std::vector<BookMove> lookup(const Position& pos, Color side) const;
+    // Weighted random choice among the book moves, weight = games played; -1 if out of book.
+    int pick(const Position& pos, Color side, std::mt19937& rng) const;
+
+private:
+    const BookPosition* find(uint64_t own, uint64_t opp) const;
+
+    MappedFile file;
+    size_t positions = 0;
+};
+
+struct BookBuildOptions {
+    int maxPlies = 20;  // positions after this many moves of a game are not recorded
+    int minGames = 2;   // moves played (and positions reached) fewer times are dropped
+};
+
+struct BookBuildStats {
+    unsigned long long games = 0, skipped = 0;  // skipped: lines that are not a legal game
+    size_t positions = 0, moves = 0;
+};
+
+// Builds a book from a corpus with one game per line as concatenated squares ("f5d6c3d3...",
+// passes implied). Games that end on the board score their moves; unfinished lines count as
+// games played with no points. Returns false if the output cannot be written.
+bool buildOpeningBook(std::istream& games, const std::string& outPath, const BookBuildOptions& options,
+                      BookBuildStats* stats = nullptr);
+
+} // namespace OthelloEngine
+
+#endif
@@ -0,0 +1,133 @@
+#include "othello_game.h"
+#include "evaluation.h"
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace OthelloEngine;
+
+OthelloGame::OthelloGame(bool computerMode, AIDifficulty difficulty)
+    : vsComputer(computerMode), ai(difficulty) {
+    initializeBoard();
+    currentPlayer = BLACK_C;
+}
+
+void OthelloGame::initializeBoard() { pos = Position::initial(); history.clear(); }
+
+char OthelloGame::cellAt(int x, int y) const {
+    int v = pos.at(squareIndex(x, y));
+    return v == 1 ? BLACK_C : v == 2 ? WHITE_C : EMPTY_C;
+}
+
+void OthelloGame::printBoard() {
+    std::cout << "  ";
+    for (int i = 0; i < BOARD_SIZE; i++) std::cout << i << " ";
+    std::cout << '\n';
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        std::cout << i << " ";
+        for (int j = 0; j < BOARD_SIZE; j++) std::cout << cellAt(i, j) << " ";
+        std::cout << '\n';
+    }
+    std::cout << "当前玩家: " << (currentPlayer == BLACK_C ? "黑棋(B)" : "白棋(W)") << '\n';
+}
+
+bool OthelloGame::isValidMove(int x, int y, char player) {
+    if (!isValidPosition(x,y)) return false;
+    return (pos.legalMoves(colorOf(player)) & squareBit(squareIndex(x,y))) != 0;
+}
+
+std::vector<std::pair<int,int>> OthelloGame::getValidMoves(char player) {
+    std::vector<std::pair<int,int>> moves;
+    uint64_t mask = pos.legalMoves(colorOf(player));
+    while (mask) { int sq = popLowestSquare(mask); moves.push_back({squareRow(sq), squareCol(sq)}); }
+    return moves;
+}
+
+std::vector<std::pair<int,int>> OthelloGame::makeMove(int x,int y,char player) {
+    std::vector<std::pair<int,int>> currentFlip;
+    if (!isValidPosition(x,y)) return currentFlip;
+    Color c = colorOf(player); int sq = squareIndex(x,y);
+    uint64_t flips = pos.flipsFor(c, sq);
+    if (!flips) return currentFlip;
+    pos.applyMove(c, sq, flips);
+    history.push(c, sq, flips);
+    while (flips) { int f = popLowestSquare(flips); currentFlip.push_back({squareRow(f), squareCol(f)}); }
+    return currentFlip;
+}
+
+int OthelloGame::evaluatePosition(char player) { return evaluate(pos, colorOf(player)); }
+
+void OthelloGame::countPieces(int& b, int& w) { b = pos.count(BLACK); w = pos.count(WHITE); }
+
+int OthelloGame::simulateMove(int x,int y,char player) {
+    if (!isValidPosition(x,y)) return 0;
+    return popCount(pos.flipsFor(colorOf(player), squareIndex(x,y)));
+}
+
+bool OthelloGame::undoMove() {
+    if (!history.canUndo()) { std::cout << "没有可撤的记录\n"; return false; }
+    // the mover of the undone move is to move again, also across a pass
+    currentPlayer = history.undo(pos) == BLACK ? BLACK_C : WHITE_C;
+    std::cout<<"撤销成功\n"; return true;
+}
+
+bool OthelloGame::redoMove() {
+    if (!history.canRedo()) { std::cout << "没有可重做的记录\n"; return false; }
+    history.redo(pos);
+    currentPlayer = history.sideToMove(pos) == BLACK ? BLACK_C : WHITE_C;
+    std::cout<<"重做成功\n"; return true;
+}
+
+bool OthelloGame::jumpToPly(int ply) {
+    if (ply < 0 || ply > history.size()) { std::cout << "步数超出范围 (0-" << history.size() << ")\n"; return false; }
+    history.jumpTo(pos, ply);
+    currentPlayer = history.sideToMove(pos) == BLACK ? BLACK_C : WHITE_C;
+    std::cout<<"已跳到第 "<<ply<<" 步\n"; return true;
+}
+
+bool OthelloGame::isGameOver() { return !pos.legalMoves(BLACK) && !pos.legalMoves(WHITE); }
+
+void OthelloGame::showResult() { int b,w; countPieces(b,w); std::cout<<"\n游戏结束\n"; std::cout<<"黑: "<<b<<" 白: "<<w<<"\n"; if (b>w) std::cout<<"黑胜\n"; else if (w>b) std::cout<<"白胜\n"; else std::cout<<"平局\n"; }
+
+std::pair<int,int> OthelloGame::computerMove() {
+    int sq = ai.chooseMove(pos, colorOf(currentPlayer));
+    if (sq < 0) return {-1,-1};
+    return {squareRow(sq), squareCol(sq)};
+}
+
+static void printSearchStats(const SearchResult& r) {
+    const SearchStats& s = r.stats;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "搜索: 深度 " << r.depth << (r.exact ? " (精确)" : "") << "  节点 " << r.nodes << "  "
+              << r.nodesPerSec() / 1e6 << "M 节点/秒  用时 " << r.elapsedMs << "ms\n";
+    std::cout << "      叶评估 " << s.leafEvals << "  剪枝 " << s.cutoffs << " (首着 " << 100 * s.firstMoveCutoffRate()
+              << "%)  置换表命中 " << 100 * s.ttHitRate() << "%  有效分支因子 " << std::setprecision(2)
+              << s.branchingFactor << '\n';
+    std::cout << "      主变例:";
+    for (int sq : s.pv) {
+        if (sq < 0) std::cout << " 跳过";
+        else std::cout << " (" << squareRow(sq) << "," << squareCol(sq) << ")";
+    }
+    std::cout << '\n';
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+void OthelloGame::playGame() {
+    std::cout<<"=== 翻转棋 (控制台) ===\n";
+    std::cout<<"输入坐标格式: 行 列 (例如: 3 4)"<<std::endl;
+    std::cout<<"输入 'undo' 撤销， 'redo' 重做， 'jump N' 跳到第 N 步， 'quit' 退出"<<std::endl;
+    while (!isGameOver()) {
+        printBoard();
+        if (!validMoveMask(currentPlayer)) { std::cout<<"当前玩家无子可下，跳过...\n"; switchPlayer(); continue; }
+        if (vsComputer && currentPlayer==WHITE_C) {
+            std::cout<<"AI 思考中...\n"; auto mv = computerMove(); if (mv.first!=-1) { makeMove(mv.first,mv.second,currentPlayer); std::cout<<"AI 下子: ("<<mv.first<<","<<mv.second<<")\n"; if (showSearchStats && ai.difficulty()==AIDifficulty::HARD) { if (ai.lastFromBook()) std::cout<<"开局库着法\n"; else printSearchStats(ai.lastResult()); } switchPlayer(); }
+        } else {
+            std::string in; std::cout<<"请输入落子或命令: "; std::cin>>in; if (in=="quit") break; if (in=="undo") { undoMove(); while (vsComputer && currentPlayer==WHITE_C && history.canUndo()) undoMove(); continue; }  // 人机: 连同 AI 的应着一起撤销
+            if (in=="redo") { redoMove(); while (vsComputer && currentPlayer==WHITE_C && history.canRedo()) redoMove(); continue; }
+            if (in=="jump") { int n; if (std::cin>>n) jumpToPly(n); else { std::cin.clear(); std::cin.ignore(10000,'\n'); } continue; }
+            try { int x = std::stoi(in); int y; std::cin>>y; if (isValidMove(x,y,currentPlayer)) { makeMove(x,y,currentPlayer); switchPlayer(); } else { std::cout<<"无效落子\n"; } }
+            catch(...) { std::cout<<"格式错误, 请用: 行 列\n"; std::cin.clear(); std::cin.ignore(10000,'\n'); }
+        }
+    }
+    if (isGameOver()) showResult();
+}
@@ -0,0 +1,72 @@
+#ifndef OTHELLO_GAME_H
+#define OTHELLO_GAME_H
+#include <vector>
+#include <utility>
+
+#include "ai_player.h"
+#include "bitboard.h"
+#include "move_history.h"
+#include "search.h"
+
+// Console Othello game shared by reversi_console and the console mode of the GUI build.
+// The position is held as an OthelloEngine::Position bitboard; coordinates in the public
+// API stay (row, col) pairs and players stay the 'B' / 'W' characters used for printing.
+
+const int BOARD_SIZE = 8;
+const char EMPTY_C = '.';
+const char BLACK_C = 'B';
+const char WHITE_C = 'W';
+
+using OthelloEngine::AIDifficulty;
+
+class OthelloGame {
+private:
+    OthelloEngine::Position pos;
+    char currentPlayer;
+    OthelloEngine::MoveHistory history;
+    bool vsComputer;
+    bool showSearchStats = false;
+    OthelloEngine::AIPlayer ai;
+
+    static OthelloEngine::Color colorOf(char player) { return player == BLACK_C ? OthelloEngine::BLACK : OthelloEngine::WHITE; }
+
+public:
+    OthelloGame(bool computerMode = false, AIDifficulty difficulty = AIDifficulty::MEDIUM);
+
+    void initializeBoard();
+    void printBoard();
+    char cellAt(int x, int y) const;
+
+    bool isValidPosition(int x, int y) { return x >= 0 && x < BOARD_SIZE && y >= 0 && y < BOARD_SIZE; }
+    bool isValidMove(int x, int y, char player);
+    std::vector<std::pair<int,int>> getValidMoves(char player);
+    // Legal moves as a bitmask (bit = row * 8 + col); no allocation, preferred on hot paths.
+    uint64_t validMoveMask(char player) const { return pos.legalMoves(colorOf(player)); }
+    std::vector<std::pair<int,int>> makeMove(int x, int y, char player);
+    void switchPlayer() { currentPlayer = (currentPlayer==BLACK_C?WHITE_C:BLACK_C); }
+
+    int evaluatePosition(char player);
+    void countPieces(int& b, int& w);
+    int simulateMove(int x, int y, char player);
+    bool undoMove();
+    bool redoMove();
+    // Review: undo / redo to `ply` moves from the start
+    bool jumpToPly(int ply);
+    bool isGameOver();
+    void showResult();
+    std::pair<int,int> computerMove();
+    // HARD mode search budget
+    void setSearchLimits(const OthelloEngine::SearchLimits& limits) { ai.setSearchLimits(limits); }
+    void setHashSize(size_t megabytes) { ai.setHashSize(megabytes); }
+    void setSearchThreads(int count) { ai.setThreads(count); }
+    // HARD mode opening book; must outlive the game
+    void setOpeningBook(const OthelloEngine::OpeningBook* book) { ai.setOpeningBook(book); }
+    // HARD mode keeps searching on the opponent's time (see AIPlayer)
+    void setPondering(bool on) { ai.setPondering(on); }
+    // Print nodes, NPS, cutoffs, TT hits, branching factor and PV after each HARD move
+    void setShowSearchStats(bool show) { showSearchStats = show; }
+    const OthelloEngine::SearchResult& lastSearch() const { return ai.lastResult(); }
+    void playGame();
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bitboard.h"
+#include "game_record.h"
+#include "opening_book.h"
+
+// File format tests: OTGR game records and OTBK opening books, no SFML dependency; run by ctest.
+// Scratch files are written to the working directory and removed again.
+
+using namespace OthelloEngine;
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cerr << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+struct Game {
+    std::vector<int> moves;
+    bool finished;
+    int margin;
+    std::string meta;
+};
+
+// Margins cover both zigzag signs and the extremes; the long metadata and the 60 moves plus
+// passes need multi-byte length varints.
+void testRecordRoundTrip() {
+    const std::string path = "record_test.otgr";
+    std::vector<int> full;
+    for (int sq = 0; sq < NUM_SQUARES; ++sq) full.push_back(sq == 27 || sq == 28 || sq == 35 || sq == 36 ? -1 : sq);
+    std::vector<Game> games = {
+        {{}, false, 0, ""},
+        {{37, 43, 18}, false, -1, "x"},
+        {{37, -1, 43}, true, 1, ""},
+        {full, true, 64, std::string(200, 'm')},
+        {full, true, -64, std::string("a\0b", 3)},
+    };
+
+    GameRecordWriter writer;
+    check(writer.open(path), "record: open for writing");
+    for (size_t i = 0; i < 3; ++i) writer.write(games[i].moves, games[i].finished, games[i].margin, games[i].meta);
+    check(writer.close(), "record: close");
+    check(writer.open(path, true), "record: reopen for append");
+    for (size_t i = 3; i < games.size(); ++i) writer.write(games[i].moves, games[i].finished, games[i].margin, games[i].meta);
+    check(writer.close(), "record: close after append");
+    check(readFile(path).compare(0, 4, "OTGR") == 0 && readFile(path).find("OTGR", 1) == std::string::npos,
+          "record: one header after append");
+
+    GameRecordReader reader;
+    check(reader.open(path), "record: open for reading");
+    GameRecord record;
+    std::vector<size_t> offsets;
+    for (const Game& g : games) {
+        if (!reader.next(record)) {
+            check(false, "record: fewer games read than written");
+            break;
+        }
+        offsets.push_back(record.offset);
+        std::string what = "record: game " + std::to_string(offsets.size());
+        check(record.finished == g.finished, what + " finished flag");
+        check(record.margin == g.margin, what + " margin");
+        check(record.metadata() == g.meta, what + " metadata");
+        bool same = record.moveCount == g.moves.size();
+        for (size_t i = 0; same && i < g.moves.size(); ++i)
+            same = record.moves[i] == (g.moves[i] < 0 ? RECORD_PASS : g.moves[i]);
+        check(same, what + " moves");
+    }
+    check(!reader.next(record) && !reader.corrupt(), "record: clean end of file");
+
+    reader.seek(offsets[3]);
+    check(reader.next(record) && record.margin == 64 && record.offset == offsets[3], "record: seek to a record");
+    check(gameRecordText(record).size() == 2 * (NUM_SQUARES - 4), "record: text form omits passes");
+    reader.close();
+
+    // a record cut short is reported as corrupt; the records before it still read
+    std::string bytes = readFile(path);
+    writeFile(path, bytes.substr(0, bytes.size() - 1));
+    check(reader.open(path), "record: open truncated file");
+    int read = 0;
+    while (reader.next(record)) ++read;
+    check(read == static_cast<int>(games.size()) - 1 && reader.corrupt(), "record: truncated last record");
+    reader.close();
+
+    // a move byte above RECORD_PASS
+    bytes[offsets[2] + 4] = static_cast<char>(RECORD_PASS + 1);
+    writeFile(path, bytes);
+    check(reader.open(path), "record: open file with a bad move");
+    read = 0;
+    while (reader.next(record)) ++read;
+    check(read == 2 && reader.corrupt(), "record: move out of range");
+    reader.close();
+
+    writeFile(path, "OTGR\x02");
+    check(!reader.open(path), "record: wrong version rejected");
+    std::remove(path.c_str());
+}
+
+uint32_t readU32(const std::string& bytes, size_t at) {
+    uint32_t v;
+    std::memcpy(&v, bytes.data() + at, 4);
+    return v;
+}
+
+void testBookValidation() {
+    const std::string path = "record_test.otbk";
+    std::istringstream corpus("f5d6c3d3c4\nf5d6c3d3c4\nf5f6e6f4\nf5f6e6f4\nf5f6e6f4\n");
+    BookBuildOptions options;
+    options.maxPlies = 4;
+    check(buildOpeningBook(corpus, path, options), "book: build");
+    const std::string good = readFile(path);
+
+    OpeningBook book;
+    check(book.open(path) && book.positionCount() > 0, "book: open");
+    std::vector<BookMove> first = book.lookup(Position::initial(), BLACK);
+    // the start position is symmetric, so f5 may come back as any of the four equivalent openings
+    check(first.size() == 1 && first[0].games == 5 && (Position::initial().legalMoves(BLACK) & squareBit(first[0].square)),
+          "book: first move");
+    book.close();
+
+    // header 32 bytes, positions 32 bytes (first move index at +24), moves 12 bytes (square at +0)
+    const uint32_t positions = readU32(good, 8), moves = readU32(good, 12);
+    check(positions > 0 && moves > 0 && good.size() == 32 + 32 * size_t(positions) + 12 * size_t(moves), "book: layout");
+
+    std::string bad = good;
+    bad[0] = 'X';
+    writeFile(path, bad);
+    check(!book.open(path), "book: bad magic rejected");
+
+    writeFile(path, good.substr(0, good.size() - 1));
+    check(!book.open(path), "book: truncated file rejected");
+
+    bad = good;
+    uint32_t firstMove = moves + 1;
+    std::memcpy(&bad[32 + 24], &firstMove, 4);
+    writeFile(path, bad);
+    check(!book.open(path), "book: move range past the end rejected");
+
+    bad = good;
+    bad[32 + 32 * size_t(positions)] = static_cast<char>(NUM_SQUARES);
+    writeFile(path, bad);
+    check(!book.open(path), "book: square out of range rejected");
+
+    writeFile(path, good);
+    check(book.open(path), "book: reopen after the corrupt copies");
+    book.close();
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    testRecordRoundTrip();
+    testBookValidation();
+    if (failures) return 1;
+    std::cout << "all tests passed\n";
+    return 0;
+}
@@ -4,7 +4,6 @@
 #include <filesystem>
 #include <algorithm>
 #include <memory>
-#include <stack>
 #include <random>
 #include <chrono>
 
@@ -13,6 +12,10 @@
 #include <array>
 
 #include "audio_manager.h"
+#include "board_renderer.h"
+#include "move_history.h"
+#include "othello_game.h"
+#include "selfplay_farm.h"
 #include "sound_definition.h"
 
 #if defined(_WIN32)
@@ -21,220 +24,12 @@
 #  include "resource.h"
 #endif
 
-// 0 = empty, 1 = black, 2 = white
 static const int BOARD_N = 8;
 
-// --- Console Othello implementation (from attachment) ---
-namespace ConsoleOthello {
-
-const int BOARD_SIZE = 8;
-const char EMPTY_C = '.';
-const char BLACK_C = 'B';
-const char WHITE_C = 'W';
-
-const int dxs[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
-const int dys[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
-
-enum class AIDifficulty { EASY, MEDIUM, HARD };
-
-class OthelloGame {
-private:
-    char board[BOARD_SIZE][BOARD_SIZE];
-    char currentPlayer;
-    std::stack<std::pair<std::pair<int, int>, std::vector<std::pair<int, int>>>> moveHistory;
-    bool vsComputer;
-    AIDifficulty aiDifficulty;
-
-    const int positionWeights[BOARD_SIZE][BOARD_SIZE] = {
-        {100, -20, 10, 5, 5, 10, -20, 100},
-        {-20, -30, -5, -5, -5, -5, -30, -20},
-        {10, -5, 1, 1, 1, 1, -5, 10},
-        {5, -5, 1, 1, 1, 1, -5, 5},
-        {5, -5, 1, 1, 1, 1, -5, 5},
-        {10, -5, 1, 1, 1, 1, -5, 10},
-        {-20, -30, -5, -5, -5, -5, -30, -20},
-        {100, -20, 10, 5, 5, 10, -20, 100}
-    };
-
-public:
-    OthelloGame(bool computerMode = false, AIDifficulty difficulty = AIDifficulty::MEDIUM)
-        : vsComputer(computerMode), aiDifficulty(difficulty) {
-        initializeBoard();
-        currentPlayer = BLACK_C;
-    }
-
-    void initializeBoard() {
-        for (int i = 0; i < BOARD_SIZE; i++)
-            for (int j = 0; j < BOARD_SIZE; j++) board[i][j] = EMPTY_C;
-        board[3][3] = WHITE_C; board[3][4] = BLACK_C; board[4][3] = BLACK_C; board[4][4] = WHITE_C;
-    }
-
-    void printBoard() {
-        std::cout << "  ";
-        for (int i = 0; i < BOARD_SIZE; i++) std::cout << i << " ";
-        std::cout << std::endl;
-        for (int i = 0; i < BOARD_SIZE; i++) {
-            std::cout << i << " ";
-            for (int j = 0; j < BOARD_SIZE; j++) std::cout << board[i][j] << " ";
-            std::cout << std::endl;
-        }
-        std::cout << "当前玩家: " << (currentPlayer == BLACK_C ? "黑棋(B)" : "白棋(W)") << std::endl;
-    }
-
-    bool isValidPosition(int x, int y) { return x >= 0 && x < BOARD_SIZE && y >= 0 && y < BOARD_SIZE; }
-
-    bool isValidMove(int x, int y, char player) {
-        if (!isValidPosition(x,y) || board[x][y] != EMPTY_C) return false;
-        char opponent = (player == BLACK_C) ? WHITE_C : BLACK_C;
-        for (int dir=0; dir<8; ++dir) {
-            int nx = x + dxs[dir], ny = y + dys[dir];
-            if (isValidPosition(nx, ny) && board[nx][ny] == opponent) {
-                nx += dxs[dir]; ny += dys[dir];
-                while (isValidPosition(nx, ny)) {
-                    if (board[nx][ny] == EMPTY_C) break;
-                    if (board[nx][ny] == player) return true;
-                    nx += dxs[dir]; ny += dys[dir];
-                }
-            }
-        }
-        return false;
-    }
-
-    std::vector<std::pair<int,int>> getValidMoves(char player) {
-        std::vector<std::pair<int,int>> moves;
-        for (int i=0;i<BOARD_SIZE;++i) for (int j=0;j<BOARD_SIZE;++j) if (isValidMove(i,j,player)) moves.push_back({i,j});
-        return moves;
-    }
-
-    std::vector<std::pair<int,int>> makeMove(int x,int y,char player) {
-        std::vector<std::pair<int,int>> flipped;
-        if (!isValidMove(x,y,player)) return flipped;
-        board[x][y] = player; char opponent = (player==BLACK_C?WHITE_C:BLACK_C);
-        std::vector<std::pair<int,int>> currentFlip;
-        for (int dir=0;dir<8;++dir) {
-            int nx=x+dxs[dir], ny=y+dys[dir]; std::vector<std::pair<int,int>> temp;
-            while (isValidPosition(nx,ny) && board[nx][ny]==opponent) { temp.push_back({nx,ny}); nx+=dxs[dir]; ny+=dys[dir]; }
-            if (isValidPosition(nx,ny) && board[nx][ny]==player) {
-                for (auto pos: temp) { board[pos.first][pos.second]=player; currentFlip.push_back(pos); }
-            }
-        }
-        moveHistory.push({{x,y}, currentFlip});
-        return currentFlip;
-    }
-
-    void switchPlayer() { currentPlayer = (currentPlayer==BLACK_C?WHITE_C:BLACK_C); }
-
-    int evaluatePosition(char player) {
-        char opponent = (player==BLACK_C?WHITE_C:BLACK_C);
-        int score=0;
-        for (int r=0;r<BOARD_SIZE;++r) for (int c=0;c<BOARD_SIZE;++c) {
-            if (board[r][c]==player) score += positionWeights[r][c]; else if (board[r][c]==opponent) score -= positionWeights[r][c];
-        }
-        int playerMobility = getValidMoves(player).size();
-        int opponentMobility = getValidMoves(opponent).size();
-        score += (playerMobility - opponentMobility) * 5;
-        return score;
-    }
-
-    void countPieces(int& b, int& w) {
-        b=0; w=0; for (int i=0;i<BOARD_SIZE;++i) for (int j=0;j<BOARD_SIZE;++j) { if (board[i][j]==BLACK_C) ++b; else if (board[i][j]==WHITE_C) ++w; }
-    }
-
-    int minimax(int depth, int alpha, int beta, bool maximizingPlayer, char player) {
-        if (depth==0) return evaluatePosition(player);
-        char opponent = (player==BLACK_C?WHITE_C:BLACK_C);
-        char current = maximizingPlayer?player:opponent;
-        if (getValidMoves(current).empty()) {
-            if (getValidMoves(opponent).empty()) { int b=0,w=0; countPieces(b,w); return (player==BLACK_C)?(b-w)*1000:(w-b)*1000; }
-            return minimax(depth-1, alpha, beta, !maximizingPlayer, player);
-        }
-        if (maximizingPlayer) {
-            int maxEval = -1000000;
-            for (int r=0;r<BOARD_SIZE;++r) for (int c=0;c<BOARD_SIZE;++c) if (isValidMove(r,c,current)) {
-                char boardCopy[BOARD_SIZE][BOARD_SIZE]; std::copy(&board[0][0], &board[0][0]+BOARD_SIZE*BOARD_SIZE, &boardCopy[0][0]);
-                makeMove(r,c,current);
-                int eval = minimax(depth-1, alpha, beta, false, player);
-                std::copy(&boardCopy[0][0], &boardCopy[0][0]+BOARD_SIZE*BOARD_SIZE, &board[0][0]);
-                maxEval = std::max(maxEval, eval); alpha = std::max(alpha, eval); if (beta <= alpha) break;
-            }
-            return maxEval;
-        } else {
-            int minEval = 1000000;
-            for (int r=0;r<BOARD_SIZE;++r) for (int c=0;c<BOARD_SIZE;++c) if (isValidMove(r,c,current)) {
-                char boardCopy[BOARD_SIZE][BOARD_SIZE]; std::copy(&board[0][0], &board[0][0]+BOARD_SIZE*BOARD_SIZE, &boardCopy[0][0]);
-                makeMove(r,c,current);
-                int eval = minimax(depth-1, alpha, beta, true, player);
-                std::copy(&boardCopy[0][0], &boardCopy[0][0]+BOARD_SIZE*BOARD_SIZE, &board[0][0]);
-                minEval = std::min(minEval, eval); beta = std::min(beta, eval); if (beta <= alpha) break;
-            }
-            return minEval;
-        }
-    }
+int runSFML();
 
-    int simulateMove(int x,int y,char player) {
-        if (!isValidMove(x,y,player)) return 0;
-        char opponent = (player==BLACK_C?WHITE_C:BLACK_C);
-        int total=0;
-        for (int d=0;d<8;++d) {
-            int nx=x+dxs[d], ny=y+dys[d], line=0;
-            while (isValidPosition(nx,ny) && board[nx][ny]==opponent) { ++line; nx+=dxs[d]; ny+=dys[d]; }
-            if (line>0 && isValidPosition(nx,ny) && board[nx][ny]==player) total+=line;
-        }
-        return total;
-    }
-
-    bool undoMove() {
-        if (moveHistory.empty()) { std::cout << "没有可撤的记录\n"; return false; }
-        auto last = moveHistory.top(); moveHistory.pop(); auto movePos = last.first; board[movePos.first][movePos.second]=EMPTY_C;
-        char opponent = (currentPlayer==BLACK_C?WHITE_C:BLACK_C);
-        for (auto pos: last.second) board[pos.first][pos.second]=opponent;
-        switchPlayer(); std::cout<<"撤销成功\n"; return true;
-    }
-
-    bool isGameOver() { return getValidMoves(BLACK_C).empty() && getValidMoves(WHITE_C).empty(); }
-
-    void showResult() { int b,w; countPieces(b,w); std::cout<<"\n游戏结束\n"; std::cout<<"黑: "<<b<<" 白: "<<w<<"\n"; if (b>w) std::cout<<"黑胜\n"; else if (w>b) std::cout<<"白胜\n"; else std::cout<<"平局\n"; }
-
-    std::pair<int,int> computerMove() {
-        auto moves = getValidMoves(currentPlayer);
-        if (moves.empty()) return {-1,-1};
-        switch (aiDifficulty) {
-        case AIDifficulty::EASY: {
-            std::vector<std::pair<int,int>> good;
-            for (auto &m: moves) { int f = simulateMove(m.first,m.second,currentPlayer); if (f>2) good.push_back(m); }
-            if (!good.empty()) { std::random_device rd; std::mt19937 gen(rd()); std::uniform_int_distribution<> dis(0, (int)good.size()-1); return good[dis(gen)]; }
-            std::random_device rd; std::mt19937 gen(rd()); std::uniform_int_distribution<> dis(0, (int)moves.size()-1); return moves[dis(gen)];
-        }
-        case AIDifficulty::MEDIUM: {
-            int best=-1; auto bestMove = moves[0]; for (auto &m: moves) { int f=simulateMove(m.first,m.second,currentPlayer); if (f>best) {best=f; bestMove=m;} } return bestMove; }
-        case AIDifficulty::HARD: {
-            int bestScore=-1000000; auto bestMove = moves[0]; for (auto &m: moves) {
-                char boardCopy[BOARD_SIZE][BOARD_SIZE]; std::copy(&board[0][0], &board[0][0]+BOARD_SIZE*BOARD_SIZE, &boardCopy[0][0]);
-                makeMove(m.first,m.second,currentPlayer); int score = minimax(3, -1000000, 1000000, false, currentPlayer);
-                std::copy(&boardCopy[0][0], &boardCopy[0][0]+BOARD_SIZE*BOARD_SIZE, &board[0][0]); if (score>bestScore) { bestScore=score; bestMove=m; }
-            } return bestMove; }
-        }
-        return moves[0];
-    }
-
-    void playGame() {
-        std::cout<<"=== 翻转棋 (控制台) ===\n";
-        std::cout<<"输入坐标格式: 行 列 (例如: 3 4)"<<std::endl;
-        std::cout<<"输入 'undo' 撤销， 'quit' 退出"<<std::endl;
-        while (!isGameOver()) {
-            printBoard(); auto valid = getValidMoves(currentPlayer);
-            if (valid.empty()) { std::cout<<"当前玩家无子可下，跳过...\n"; switchPlayer(); continue; }
-            if (vsComputer && currentPlayer==WHITE_C) {
-                std::cout<<"AI 思考中...\n"; auto mv = computerMove(); if (mv.first!=-1) { makeMove(mv.first,mv.second,currentPlayer); std::cout<<"AI 下子: ("<<mv.first<<","<<mv.second<<")\n"; switchPlayer(); }
-            } else {
-                std::string in; std::cout<<"请输入落子或命令: "; std::cin>>in; if (in=="quit") break; if (in=="undo") { undoMove(); continue; }
-                try { int x = std::stoi(in); int y; std::cin>>y; if (isValidMove(x,y,currentPlayer)) { makeMove(x,y,currentPlayer); switchPlayer(); } else { std::cout<<"无效落子\n"; } }
-                catch(...) { std::cout<<"格式错误, 请用: 行 列\n"; std::cin.clear(); std::cin.ignore(10000,'\n'); }
-            }
-        }
-        if (isGameOver()) showResult();
-    }
-};
+// --- Console mode: shared OthelloGame (othello_game.cpp) ---
+namespace ConsoleOthello {
 
 int runConsoleGame() {
     std::cout << "请选择模式: 1. 双人 2. 人机(简单) 3. 人机(中等) 4. 人机(困难)\n";
@@ -247,6 +42,8 @@ int runConsoleGame() {
     return 0;
 }
 
+} // namespace ConsoleOthello
+
 int main() {
     std::cout << "请选择运行模式:\n1) GUI (SFML)\n2) 控制台模式\n输入数字并回车: ";
     int mode = 1;
@@ -258,13 +55,11 @@ int main() {
     }
 }
 
-} // namespace ConsoleOthello
-
 // --- End of console implementation ---
 
 
 int runSFML() {
-    enum class GameState { Start, Playing, End };
+    enum class GameState { Start, Playing, End, Spectate };
     GameState gameState = GameState::Start;
     enum class GameMode { None, PvP, PvC };
     GameMode gameMode = GameMode::None;
@@ -384,7 +179,7 @@ int runSFML() {
     // 尝试加载默认音效目录（文件可能不存在，加载失败会被忽略）
     for (int i = 0; i < NUM_SOUNDS; ++i) {
         const SoundConfig &cfg = DEFAULT_SOUNDS[i];
-        audio.loadSound(cfg.name, cfg.filename);
+        audio.loadSound(cfg.type, cfg.filename);
     }
 
     // 全局比分统计（每局胜利计数）
@@ -400,8 +195,24 @@ int runSFML() {
     starterText.setFillColor(sf::Color::White);
     starterText.setPosition(sf::Vector2f(winW/2.f-120.f, 380.f));
 
-    // 历史记录：每步保存棋盘和当前玩家
-    std::vector<std::pair<int[BOARD_N][BOARD_N], int>> history;
+    // 人机难度（按 D 切换），与控制台共用 OthelloEngine::AIPlayer
+    AIDifficulty difficulty = AIDifficulty::MEDIUM;
+    auto difficultyLabel = [&]() {
+        const char* names[] = {"Easy", "Medium", "Hard"};
+        return std::string("Difficulty: ") + names[static_cast<int>(difficulty)] + "   (D to change)";
+    };
+    sf::Text difficultyText = makeText(font, difficultyLabel(), 20);
+    difficultyText.setFillColor(sf::Color::White);
+    difficultyText.setPosition(sf::Vector2f(winW/2.f-120.f, 420.f));
+    // 预搜索（pondering）默认关闭：开启后玩家思考期间会占满一个核心
+    bool pondering = false;
+    auto ponderLabel = [&]() { return std::string("Ponder (Hard): ") + (pondering ? "On" : "Off") + "   (P to toggle)"; };
+    sf::Text ponderText = makeText(font, ponderLabel(), 20);
+    ponderText.setFillColor(sf::Color::White);
+    ponderText.setPosition(sf::Vector2f(winW/2.f-120.f, 460.f));
+    sf::Text spectateHint = makeText(font, "S: watch engine games", 20);
+    spectateHint.setFillColor(sf::Color::White);
+    spectateHint.setPosition(sf::Vector2f(winW/2.f-120.f, 500.f));
 
     // VideoMode construction differs between SFML 2 and 3
 #if defined(SFML_VERSION_MAJOR) && (SFML_VERSION_MAJOR >= 3)
@@ -416,113 +227,45 @@ int runSFML() {
     );
     window.setFramerateLimit(60);
 
-    // 棋盘数据
-    int board[BOARD_N][BOARD_N] = {0};
-    int currentPlayer = 1; // 黑先
-    // 初始四子
-    board[3][3] = 2; // 白
-    board[3][4] = 1; // 黑
-    board[4][3] = 1; // 黑
-    board[4][4] = 2; // 白
-
-    // 方向数组
-    const int dx[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
-    const int dy[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
-
-    // 判断坐标是否合法
-    auto isValidPos = [&](int r, int c) {
-        return r >= 0 && r < BOARD_N && c >= 0 && c < BOARD_N;
-    };
+    // 棋局状态：共享引擎的位棋盘（规则、走法生成与 AI 都在 othello_engine 中）
+    using OthelloEngine::BLACK;
+    using OthelloEngine::WHITE;
+    OthelloEngine::Position pos = OthelloEngine::Position::initial();
+    OthelloEngine::Color currentPlayer = BLACK; // 黑先
 
-    // 判断落子是否合法
-    auto isValidMove = [&](int r, int c, int player) {
-        if (!isValidPos(r, c) || board[r][c] != 0) return false;
-        int opponent = (player == 1 ? 2 : 1);
-        for (int d = 0; d < 8; ++d) {
-            int nr = r + dx[d], nc = c + dy[d];
-            if (isValidPos(nr, nc) && board[nr][nc] == opponent) {
-                nr += dx[d]; nc += dy[d];
-                while (isValidPos(nr, nc)) {
-                    if (board[nr][nc] == 0) break;
-                    if (board[nr][nc] == player) return true;
-                    nr += dx[d]; nc += dy[d];
-                }
-            }
-        }
-        return false;
-    };
+    // 历史记录：每步保存落子格、翻转掩码和落子方（与控制台共用），支持悔棋、重做和跳转
+    OthelloEngine::MoveHistory history;
 
-    auto hasValidAny = [&](int player) {
-        for (int r = 0; r < BOARD_N; ++r)
-            for (int c = 0; c < BOARD_N; ++c)
-                if (isValidMove(r, c, player)) return true;
-        return false;
-    };
+    // 开局库（可选）：存在 opening_book.bin 时困难模式直接按库落子；须在 ai 之前构造、之后析构
+    OthelloEngine::OpeningBook book;
+    if (book.open("opening_book.bin")) std::cout << "[Info] Opening book: " << book.positionCount() << " positions" << std::endl;
 
-    auto countDiscs = [&]() {
-        int b=0,w=0;
-        for (int r=0;r<BOARD_N;++r)
-            for (int c=0;c<BOARD_N;++c)
-                if (board[r][c]==1) ++b; else if (board[r][c]==2) ++w;
-        return std::pair<int,int>(b,w);
-    };
+    // 电脑玩家（白棋）：在工作线程上计算，渲染循环不被阻塞；困难模式可选在玩家思考时预先搜索
+    OthelloEngine::AIPlayer ai(difficulty);
+    ai.setPondering(pondering);
+    if (book.isOpen()) ai.setOpeningBook(&book);
 
-    // 执行落子并翻子
-    auto makeMove = [&](int r, int c, int player) {
-        std::vector<std::pair<int,int>> flipped;
-        if (!isValidMove(r, c, player)) return flipped;
-        board[r][c] = player;
-        int opponent = (player == 1 ? 2 : 1);
-        for (int d = 0; d < 8; ++d) {
-            int nr = r + dx[d], nc = c + dy[d];
-            std::vector<std::pair<int,int>> temp;
-            while (isValidPos(nr, nc) && board[nr][nc] == opponent) {
-                temp.push_back({nr, nc});
-                nr += dx[d]; nc += dy[d];
-            }
-            if (isValidPos(nr, nc) && board[nr][nc] == player) {
-                for (auto& p : temp) {
-                    board[p.first][p.second] = player;
-                    flipped.push_back(p);
-                }
-            }
-        }
-        return flipped;
+    auto isValidMove = [&](int r, int c) {
+        return (pos.legalMoves(currentPlayer) & OthelloEngine::squareBit(r * BOARD_N + c)) != 0;
     };
-
-    // 评估某一步可翻子的数量（不修改棋盘）
-    auto evalFlipCount = [&](int r, int c, int player)->int {
-        if (!isValidMove(r,c,player)) return 0;
-        int opponent = (player==1?2:1);
-        int total=0;
-        for (int d=0; d<8; ++d) {
-            int nr=r+dx[d], nc=c+dy[d];
-            int line=0;
-            while (isValidPos(nr,nc) && board[nr][nc]==opponent) {
-                ++line; nr+=dx[d]; nc+=dy[d];
-            }
-            if (line>0 && isValidPos(nr,nc) && board[nr][nc]==player) total+=line;
-        }
-        return total;
-    };
-
-    auto saveHistory = [&]() {
-        int boardCopy[BOARD_N][BOARD_N];
-        std::copy(&board[0][0], &board[0][0] + BOARD_N*BOARD_N, &boardCopy[0][0]);
-        history.push_back({});
-        std::copy(&boardCopy[0][0], &boardCopy[0][0] + BOARD_N*BOARD_N, &history.back().first[0][0]);
-        history.back().second = currentPlayer;
+    auto hasValidAny = [&](OthelloEngine::Color player) { return pos.legalMoves(player) != 0; };
+    auto playMove = [&](OthelloEngine::Color side, int sq) { history.push(side, sq, pos.makeMove(side, sq)); };
+    auto resetGame = [&]() {
+        ai.newGame();
+        pos = OthelloEngine::Position::initial();
+        currentPlayer = BLACK;
+        history.clear();
     };
 
     auto checkEndOrPass = [&]() {
         // 若当前玩家无棋可下，尝试跳过给对手；若双方都无棋可下则结束
         if (!hasValidAny(currentPlayer)) {
-            int other = (currentPlayer==1?2:1);
+            OthelloEngine::Color other = OthelloEngine::opponentOf(currentPlayer);
             if (hasValidAny(other)) {
                 currentPlayer = other; // 跳过
             } else {
                 // 结束
-                auto [b,w] = countDiscs();
+                int b = pos.count(BLACK), w = pos.count(WHITE);
                 // endScore will include current game score and running totals (after update)
                 if (gameMode == GameMode::PvC) {
                     // 人类=黑棋，AI=白棋
@@ -541,20 +284,15 @@ int runSFML() {
                 std::string totalLine = "Total - BlackWins: " + std::to_string(totalBlackWins)
                     + "  WhiteWins: " + std::to_string(totalWhiteWins) + "  Draws: " + std::to_string(totalDraws);
                 endScore.setString(scoreLine + "\n" + totalLine);
-                audio.playSound("game_end");
+                audio.playSound(SoundType::GAME_END);
                 gameState = GameState::End;
             }
         }
     };
 
-    // 棋盘底色
-    sf::RectangleShape tile({cell, cell});
-    sf::Color green1(30, 120, 30);
-    sf::Color green2(20, 100, 20);
-
-    // 棋子圆形
-    sf::CircleShape disc(cell * 0.40f); // 半径
-    disc.setOrigin({disc.getRadius(), disc.getRadius()});
+    // 棋盘与棋子：缓存的顶点数组，仅在棋子变化时重建
+    BoardRenderer boardView;
+    boardView.setLayout({margin, margin}, cell);
 
     auto toBoardRC = [&](sf::Vector2i mouse) -> std::pair<int,int> {
         float x = mouse.x - margin;
@@ -568,26 +306,174 @@ int runSFML() {
         return {r, c};
     };
 
+    std::chrono::steady_clock::time_point thinkStart;
+    sf::Text thinkingText = makeText(font, "", 22);
+    thinkingText.setFillColor(sf::Color::White);
+    thinkingText.setOutlineColor(sf::Color::Black);
+    thinkingText.setOutlineThickness(2.f);
+    thinkingText.setPosition(sf::Vector2f(margin, 6.f));
+    // 人类回合：PvP 任意一方，PvC 仅黑棋（AI 思考时忽略点击）
+    auto humanTurn = [&]() { return gameMode != GameMode::PvC || currentPlayer == BLACK; };
+    // 悔棋：PvC 中退回到上一个轮到玩家的局面（连同 AI 的应着一起撤销）
+    auto undoLast = [&]() {
+        ai.cancelMove();  // 丢弃正在进行的搜索
+        while (history.canUndo()) {
+            currentPlayer = history.undo(pos);
+            if (humanTurn()) break;
+        }
+    };
+    // 重做：PvC 中连同 AI 的应着一起重做
+    auto redoNext = [&]() {
+        ai.cancelMove();
+        while (history.canRedo()) {
+            history.redo(pos);
+            currentPlayer = history.sideToMove(pos);
+            if (humanTurn()) break;
+        }
+    };
+    // 跳转到第 ply 步（复盘）
+    auto jumpTo = [&](int ply) {
+        ai.cancelMove();
+        history.jumpTo(pos, ply);
+        currentPlayer = history.sideToMove(pos);
+    };
+
+    // 观战：后台线程池持续进行引擎对局，grid x grid 块棋盘共用两个顶点数组绘制
+    std::unique_ptr<OthelloEngine::SelfPlayFarm> farm;
+    int spectateGrid = 4;
+    float farmCell = 0.f;
+    unsigned long long farmVersion = 0;
+    sf::VertexArray farmBackground(sf::PrimitiveType::Triangles), farmDiscs(sf::PrimitiveType::Triangles);
+    sf::Text spectateText = makeText(font, "", 18);
+    spectateText.setFillColor(sf::Color::White);
+    spectateText.setPosition(sf::Vector2f(margin, 10.f));
+    auto farmOrigin = [&](int i) {
+        float tile = boardSize / spectateGrid, pad = (tile - BOARD_N * farmCell) / 2.f;
+        return sf::Vector2f(margin + (i % spectateGrid) * tile + pad, margin + (i / spectateGrid) * tile + pad);
+    };
+    auto startSpectating = [&](int grid) {
+        farm.reset();  // 先停止上一组对局
+        spectateGrid = grid;
+        farmCell = boardSize / grid * 0.92f / BOARD_N;
+        OthelloEngine::FarmOptions options;
+        options.boards = grid * grid;
+        options.level = difficulty;
+        farm.reset(new OthelloEngine::SelfPlayFarm(options));
+        farmBackground.clear();
+        for (int i = 0; i < options.boards; ++i) appendBoardBackground(farmBackground, farmOrigin(i), farmCell);
+        farmVersion = ~0ULL;
+        farm->start();
+        gameState = GameState::Spectate;
+    };
+
+    // 事件驱动重绘：画面有变化（输入、AI 落子、思考提示动画）时才重绘，否则阻塞等待事件
+    bool dirty = true;
+    int thinkPhase = -1;  // 思考提示省略号的帧（0-2），-1 表示未在思考
+    const int THINK_POLL_MS = 10;  // AI 思考或观战时检查变化的间隔
+#if defined(SFML_VERSION_MAJOR) && (SFML_VERSION_MAJOR >= 3)
+    std::optional<sf::Event> pendingEvent;  // 等待时取到的事件，交给下一次 nextEvent
+    auto nextEvent = [&]() {
+        std::optional<sf::Event> event;
+        if (pendingEvent) event.swap(pendingEvent);
+        else event = window.pollEvent();
+        if (event && !event->is<sf::Event::MouseMoved>()) dirty = true;
+        return event;
+    };
+    // 阻塞直到有事件，timeoutMs >= 0 时最多等待这么久
+    auto waitForEvent = [&](int timeoutMs) {
+        pendingEvent = timeoutMs < 0 ? window.waitEvent() : window.waitEvent(sf::milliseconds(timeoutMs));
+    };
+#else
+    sf::Event pendingEvent;
+    bool hasPendingEvent = false;
+    auto nextEvent = [&](sf::Event& ev) {
+        if (hasPendingEvent) { ev = pendingEvent; hasPendingEvent = false; }
+        else if (!window.pollEvent(ev)) return false;
+        if (ev.type != sf::Event::MouseMoved) dirty = true;
+        return true;
+    };
+    auto waitForEvent = [&](int timeoutMs) {
+        if (timeoutMs < 0) { hasPendingEvent = window.waitEvent(pendingEvent); return; }
+        // SFML 2 的 waitEvent 没有超时参数
+        hasPendingEvent = window.pollEvent(pendingEvent);
+        if (!hasPendingEvent) sf::sleep(sf::milliseconds(timeoutMs));
+    };
+#endif
+
     while (window.isOpen()) {
+        if (!dirty) {
+            bool polling = (gameState == GameState::Playing && ai.thinking()) || gameState == GameState::Spectate;
+            waitForEvent(polling ? THINK_POLL_MS : -1);
+        }
+        if (gameState == GameState::Spectate) {
+#if defined(SFML_VERSION_MAJOR) && (SFML_VERSION_MAJOR >= 3)
+            while (auto event = nextEvent()) {
+                if (event->is<sf::Event::Closed>()) window.close();
+                else if (event->is<sf::Event::KeyPressed>()) {
+                    auto key = event->getIf<sf::Event::KeyPressed>()->code;
+                    if (key == sf::Keyboard::Key::Escape) { farm.reset(); gameState = GameState::Start; }
+                    else if (key == sf::Keyboard::Key::Tab) startSpectating(spectateGrid == 4 ? 8 : 4);
+                }
+            }
+#else
+            sf::Event ev;
+            while (nextEvent(ev)) {
+                if (ev.type == sf::Event::Closed) window.close();
+                else if (ev.type == sf::Event::KeyPressed) {
+                    if (ev.key.code == sf::Keyboard::Escape) { farm.reset(); gameState = GameState::Start; }
+                    else if (ev.key.code == sf::Keyboard::Tab) startSpectating(spectateGrid == 4 ? 8 : 4);
+                }
+            }
+#endif
+            if (gameState != GameState::Spectate) continue;
+            if (farm->version() != farmVersion) {
+                // 有棋盘变化：重建全部棋子顶点（一个数组，一次 draw）
+                farmVersion = farm->version();
+                farmDiscs.clear();
+                for (int i = 0; i < farm->boardCount(); ++i) {
+                    OthelloEngine::FarmBoard b = farm->board(i);
+                    appendBoardDiscs(farmDiscs, farmOrigin(i), farmCell, b.pos.discs[BLACK], b.pos.discs[WHITE]);
+                }
+                spectateText.setString(std::to_string(farm->boardCount()) + " games   Black " + std::to_string(farm->blackWins())
+                    + "  White " + std::to_string(farm->whiteWins()) + "  Draw " + std::to_string(farm->draws())
+                    + "   Tab: 4x4/8x8   Esc: back");
+                dirty = true;
+            }
+            if (dirty) {
+                window.clear({12, 60, 12});
+                window.draw(farmBackground);
+                window.draw(farmDiscs);
+                window.draw(spectateText);
+                window.display();
+                dirty = false;
+            }
+            continue;
+        }
     if (gameState == GameState::Start) {
-            window.clear({20,40,60});
-            window.draw(title);
-            window.draw(btn1); window.draw(btn2);
-            window.draw(txt1); window.draw(txt2);
-            window.draw(starterText);
-            window.display();
+            if (dirty) {
+                window.clear({20,40,60});
+                window.draw(title);
+                window.draw(btn1); window.draw(btn2);
+                window.draw(txt1); window.draw(txt2);
+                window.draw(starterText);
+                window.draw(difficultyText);
+                window.draw(ponderText);
+                window.draw(spectateHint);
+                window.display();
+                dirty = false;
+            }
             // Events for Start screen
 #if defined(SFML_VERSION_MAJOR) && (SFML_VERSION_MAJOR >= 3)
-            while (auto event = window.pollEvent()) {
+            while (auto event = nextEvent()) {
                 if (event->is<sf::Event::Closed>()) window.close();
                 else if (event->is<sf::Event::MouseButtonPressed>()) {
                     auto mouse = event->getIf<sf::Event::MouseButtonPressed>();
                     sf::Vector2f mp(static_cast<float>(mouse->position.x), static_cast<float>(mouse->position.y));
                     if (btn1.getGlobalBounds().contains(mp)) {
-                        audio.playSound("button_click");
-                        gameMode = GameMode::PvC; gameState = GameState::Playing;
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                        gameMode = GameMode::PvC; gameState = GameState::Playing; ai.setDifficulty(difficulty);
                     } else if (btn2.getGlobalBounds().contains(mp)) {
-                        audio.playSound("button_click");
+                        audio.playSound(SoundType::BUTTON_CLICK);
                         gameMode = GameMode::PvP; gameState = GameState::Playing;
                     }
                 } else if (event->is<sf::Event::KeyPressed>()) {
@@ -596,21 +482,33 @@ int runSFML() {
                     if (key == sf::Keyboard::Key::F) {
                         playerStartsBlack = !playerStartsBlack;
                         starterText.setString(playerStartsBlack ? "先手: 玩家(黑)" : "先手: 电脑(白)");
-                        audio.playSound("button_click");
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                    } else if (key == sf::Keyboard::Key::D) {
+                        difficulty = static_cast<AIDifficulty>((static_cast<int>(difficulty) + 1) % 3);
+                        difficultyText.setString(difficultyLabel());
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                    } else if (key == sf::Keyboard::Key::P) {
+                        pondering = !pondering;
+                        ai.setPondering(pondering);
+                        ponderText.setString(ponderLabel());
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                    } else if (key == sf::Keyboard::Key::S) {
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                        startSpectating(spectateGrid);
                     }
                 }
             }
 #else
             sf::Event ev;
-            while (window.pollEvent(ev)) {
+            while (nextEvent(ev)) {
                 if (ev.type == sf::Event::Closed) window.close();
                 else if (ev.type == sf::Event::MouseButtonPressed) {
                     sf::Vector2f mp(static_cast<float>(ev.mouseButton.x), static_cast<float>(ev.mouseButton.y));
                     if (btn1.getGlobalBounds().contains(mp)) {
-                        audio.playSound("button_click");
-                        gameMode = GameMode::PvC; gameState = GameState::Playing;
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                        gameMode = GameMode::PvC; gameState = GameState::Playing; ai.setDifficulty(difficulty);
                     } else if (btn2.getGlobalBounds().contains(mp)) {
-                        audio.playSound("button_click");
+                        audio.playSound(SoundType::BUTTON_CLICK);
                         gameMode = GameMode::PvP; gameState = GameState::Playing;
                     }
                 } else if (ev.type == sf::Event::KeyPressed) {
@@ -618,7 +516,19 @@ int runSFML() {
                     if (key == sf::Keyboard::F) {
                         playerStartsBlack = !playerStartsBlack;
                         starterText.setString(playerStartsBlack ? "先手: 玩家(黑)" : "先手: 电脑(白)");
-                        audio.playSound("button_click");
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                    } else if (key == sf::Keyboard::D) {
+                        difficulty = static_cast<AIDifficulty>((static_cast<int>(difficulty) + 1) % 3);
+                        difficultyText.setString(difficultyLabel());
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                    } else if (key == sf::Keyboard::P) {
+                        pondering = !pondering;
+                        ai.setPondering(pondering);
+                        ponderText.setString(ponderLabel());
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                    } else if (key == sf::Keyboard::S) {
+                        audio.playSound(SoundType::BUTTON_CLICK);
+                        startSpectating(spectateGrid);
                     }
                 }
             }
@@ -627,170 +537,137 @@ int runSFML() {
         }
         if (gameState == GameState::End) {
 #if defined(SFML_VERSION_MAJOR) && (SFML_VERSION_MAJOR >= 3)
-            while (auto event = window.pollEvent()) {
+            while (auto event = nextEvent()) {
                 if (event->is<sf::Event::Closed>()) window.close();
                 else if (event->is<sf::Event::KeyPressed>()) {
                     auto key = event->getIf<sf::Event::KeyPressed>()->code;
                     if (key == sf::Keyboard::Key::Enter) {
-                        std::fill(&board[0][0], &board[0][0]+BOARD_N*BOARD_N, 0);
-                        board[3][3]=2; board[3][4]=1; board[4][3]=1; board[4][4]=2;
-                        history.clear(); currentPlayer=1; gameState = GameState::Playing;
+                        resetGame(); gameState = GameState::Playing;
                     } else if (key == sf::Keyboard::Key::Escape) {
-                        std::fill(&board[0][0], &board[0][0]+BOARD_N*BOARD_N, 0);
-                        board[3][3]=2; board[3][4]=1; board[4][3]=1; board[4][4]=2;
-                        history.clear(); currentPlayer=1; gameMode = GameMode::None; gameState = GameState::Start;
+                        resetGame(); gameMode = GameMode::None; gameState = GameState::Start;
                     }
                 }
             }
 #else
             sf::Event ev;
-            while (window.pollEvent(ev)) {
+            while (nextEvent(ev)) {
                 if (ev.type == sf::Event::Closed) window.close();
                 else if (ev.type == sf::Event::KeyPressed) {
                     auto key = ev.key.code;
                     if (key == sf::Keyboard::Enter) {
-                        std::fill(&board[0][0], &board[0][0]+BOARD_N*BOARD_N, 0);
-                        board[3][3]=2; board[3][4]=1; board[4][3]=1; board[4][4]=2;
-                        history.clear(); currentPlayer=1; gameState = GameState::Playing;
+                        resetGame(); gameState = GameState::Playing;
                     } else if (key == sf::Keyboard::Escape) {
-                        std::fill(&board[0][0], &board[0][0]+BOARD_N*BOARD_N, 0);
-                        board[3][3]=2; board[3][4]=1; board[4][3]=1; board[4][4]=2;
-                        history.clear(); currentPlayer=1; gameMode = GameMode::None; gameState = GameState::Start;
+                        resetGame(); gameMode = GameMode::None; gameState = GameState::Start;
                     }
                 }
             }
 #endif
-            window.clear({20,40,60});
-            window.draw(endTitle);
-            window.draw(endResult);
-            window.draw(endScore);
-            window.draw(endHint);
-            window.display();
+            if (dirty && gameState == GameState::End) {
+                window.clear({20,40,60});
+                window.draw(endTitle);
+                window.draw(endResult);
+                window.draw(endScore);
+                window.draw(endHint);
+                window.display();
+                dirty = false;
+            }
             continue;
         }
         // Events for Playing state
 #if defined(SFML_VERSION_MAJOR) && (SFML_VERSION_MAJOR >= 3)
-        while (auto event = window.pollEvent()) {
+        while (auto event = nextEvent()) {
             if (event->is<sf::Event::KeyPressed>()) {
-                if (event->getIf<sf::Event::KeyPressed>()->code == sf::Keyboard::Key::Z) {
-                    if (!history.empty()) {
-                        auto& last = history.back();
-                        std::copy(&last.first[0][0], &last.first[0][0] + BOARD_N*BOARD_N, &board[0][0]);
-                        currentPlayer = last.second; history.pop_back();
-                    }
-                }
+                auto key = event->getIf<sf::Event::KeyPressed>()->code;
+                if (key == sf::Keyboard::Key::Z) undoLast();
+                else if (key == sf::Keyboard::Key::Y) redoNext();
+                else if (key == sf::Keyboard::Key::Home) jumpTo(0);
+                else if (key == sf::Keyboard::Key::End) jumpTo(history.size());
+                else if (key == sf::Keyboard::Key::Space) ai.moveNow();  // 立即落子：停止搜索，使用当前最佳着法
             }
             if (event->is<sf::Event::Closed>()) {
                 window.close();
             } else if (event->is<sf::Event::MouseButtonPressed>()) {
-                if (event->getIf<sf::Event::MouseButtonPressed>()->button == sf::Mouse::Button::Left) {
+                if (event->getIf<sf::Event::MouseButtonPressed>()->button == sf::Mouse::Button::Left && humanTurn()) {
                     auto rc = toBoardRC(sf::Mouse::getPosition(window));
                     int r = rc.first, c = rc.second;
-                    if (r != -1 && isValidMove(r, c, currentPlayer)) {
-                        saveHistory(); makeMove(r, c, currentPlayer);
-                        audio.playSound("place_piece");
-                        currentPlayer = (currentPlayer == 1 ? 2 : 1); checkEndOrPass();
+                    if (r != -1 && isValidMove(r, c)) {
+                        playMove(currentPlayer, r * BOARD_N + c);
+                        audio.playSound(SoundType::PIECE_PLACED);
+                        currentPlayer = OthelloEngine::opponentOf(currentPlayer); checkEndOrPass();
                     }
                 }
             }
         }
 #else
         sf::Event ev;
-        while (window.pollEvent(ev)) {
+        while (nextEvent(ev)) {
             if (ev.type == sf::Event::KeyPressed) {
-                if (ev.key.code == sf::Keyboard::Z) {
-                    if (!history.empty()) {
-                        auto& last = history.back();
-                        std::copy(&last.first[0][0], &last.first[0][0] + BOARD_N*BOARD_N, &board[0][0]);
-                        currentPlayer = last.second; history.pop_back();
-                    }
-                }
+                if (ev.key.code == sf::Keyboard::Z) undoLast();
+                else if (ev.key.code == sf::Keyboard::Y) redoNext();
+                else if (ev.key.code == sf::Keyboard::Home) jumpTo(0);
+                else if (ev.key.code == sf::Keyboard::End) jumpTo(history.size());
+                else if (ev.key.code == sf::Keyboard::Space) ai.moveNow();
             }
             if (ev.type == sf::Event::Closed) {
                 window.close();
             } else if (ev.type == sf::Event::MouseButtonPressed) {
-                if (ev.mouseButton.button == sf::Mouse::Left) {
+                if (ev.mouseButton.button == sf::Mouse::Left && humanTurn()) {
                     auto rc = toBoardRC(sf::Mouse::getPosition(window));
                     int r = rc.first, c = rc.second;
-                    if (r != -1 && isValidMove(r, c, currentPlayer)) {
-                        saveHistory(); makeMove(r, c, currentPlayer);
-                        audio.playSound("place_piece");
-                        currentPlayer = (currentPlayer == 1 ? 2 : 1); checkEndOrPass();
+                    if (r != -1 && isValidMove(r, c)) {
+                        playMove(currentPlayer, r * BOARD_N + c);
+                        audio.playSound(SoundType::PIECE_PLACED);
+                        currentPlayer = OthelloEngine::opponentOf(currentPlayer); checkEndOrPass();
                     }
                 }
             }
         }
 #endif
 
-        // PvC：AI为白棋（2），轮到AI则下子（简单贪心：翻子数最多）
-        if (gameState == GameState::Playing && gameMode == GameMode::PvC && currentPlayer == 2) {
-            int bestR=-1,bestC=-1,bestFlip=0;
-            for (int r=0;r<BOARD_N;++r) {
-                for (int c=0;c<BOARD_N;++c) {
-                    int f = evalFlipCount(r,c,2);
-                    if (f>bestFlip) { bestFlip=f; bestR=r; bestC=c; }
+        // PvC：AI为白棋。轮到AI时启动后台搜索，之后每帧检查结果是否就绪
+        if (gameState == GameState::Playing && gameMode == GameMode::PvC && currentPlayer == WHITE) {
+            if (!ai.thinking()) {
+                if (hasValidAny(WHITE)) {
+                    ai.startMove(pos, WHITE);
+                    thinkStart = std::chrono::steady_clock::now();
+                } else {
+                    // AI无棋可下，尝试切回玩家；若玩家也无棋则结束
+                    checkEndOrPass();
+                }
+            } else if (ai.moveReady()) {
+                int sq = ai.takeMove();
+                if (sq >= 0) {
+                    playMove(WHITE, sq);
+                    audio.playSound(SoundType::PIECE_PLACED);
+                    currentPlayer = BLACK;
                 }
-            }
-            if (bestFlip>0) {
-                saveHistory();
-                makeMove(bestR,bestC,2);
-                audio.playSound("place_piece");
-                currentPlayer = 1;
-                checkEndOrPass();
-            } else {
-                // AI无棋可下，尝试切回玩家；若玩家也无棋则结束
                 checkEndOrPass();
+                dirty = true;
             }
         }
+        if (gameState != GameState::Playing) continue;  // 结束页在下一轮绘制
 
-        window.clear({12, 60, 12});
-
-        // 绘制棋盘格
-        for (int r = 0; r < BOARD_N; ++r) {
-            for (int c = 0; c < BOARD_N; ++c) {
-                bool alt = ((r + c) % 2 == 0);
-                tile.setFillColor(alt ? green1 : green2);
-                tile.setPosition({margin + c * cell, margin + r * cell});
-                window.draw(tile);
-            }
-        }
-
-        // 网格线（可选）
-        sf::RectangleShape line;
-        line.setFillColor({0, 0, 0, 80});
-        // 竖线
-        for (int c = 0; c <= BOARD_N; ++c) {
-            line.setSize({2.f, boardSize});
-            line.setPosition({margin + c * cell, margin});
-            window.draw(line);
+        // 思考提示：动态省略号（Space 立即落子，Z 取消并悔棋），每 300 ms 换一帧
+        int phase = -1;
+        if (ai.thinking()) {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - thinkStart).count();
+            phase = static_cast<int>((ms / 300) % 3);
         }
-        // 横线
-        for (int r = 0; r <= BOARD_N; ++r) {
-            line.setSize({boardSize, 2.f});
-            line.setPosition({margin, margin + r * cell});
-            window.draw(line);
+        if (phase != thinkPhase) {
+            thinkPhase = phase;
+            if (phase >= 0) thinkingText.setString("Thinking" + std::string(1 + phase, '.') + "   Space: move now   Z: undo");
+            dirty = true;
         }
+        if (!dirty) continue;
 
-        // 绘制棋子
-        for (int r = 0; r < BOARD_N; ++r) {
-            for (int c = 0; c < BOARD_N; ++c) {
-                if (board[r][c] == 0) continue;
-                float cx = margin + c * cell + cell / 2.f;
-                float cy = margin + r * cell + cell / 2.f;
-                disc.setPosition({cx, cy});
-                if (board[r][c] == 1) {
-                    disc.setFillColor(sf::Color::Black);
-                    disc.setOutlineColor({230,230,230});
-                } else {
-                    disc.setFillColor(sf::Color::White);
-                    disc.setOutlineColor({30,30,30});
-                }
-                disc.setOutlineThickness(3.f);
-                window.draw(disc);
-            }
-        }
+        window.clear({12, 60, 12});
+
+        boardView.setPosition(pos);
+        window.draw(boardView);
+        if (thinkPhase >= 0) window.draw(thinkingText);
 
         window.display();
+        dirty = false;
     }
 
     return 0;
@@ -0,0 +1,349 @@
+#include "search.h"
+#include "evaluation.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace OthelloEngine {
+
+using Clock = std::chrono::steady_clock;
+
+// Per-thread search state. Only the transposition table and the stop flag are shared.
+class SearchWorker {
+public:
+    SearchWorker(Searcher& owner, int id) : owner(owner), id(id) {}
+
+    // Iterative deepening from the root; fills `result` with the deepest completed iteration.
+    void run(const Position& rootPos, Color side, int maxDepth, int timeMs, Clock::time_point start);
+    void clearHistory() { for (auto& row : history) for (int& h : row) h = 0; }
+
+    SearchResult result;
+    TTStats ttStats;
+    SearchStats stats;  // counters only
+    unsigned long long nodes = 0;
+
+private:
+    static const int MAX_PLY = 64;
+    static const int MOBILITY_ORDER_DEPTH = 3;
+    // Floor on how much one more iteration multiplies the elapsed time. Measured from the start
+    // position to 40 plies it is 3.1-3.3 per ply (nodes^(1/depth) reads 3.8-4.6, overestimating it).
+    static constexpr double MIN_ITERATION_GROWTH = 3.0;
+
+    int negamax(Position& pos, Color side, uint64_t hash, int depth, int ply, int alpha, int beta, bool passed);
+    void orderMoves(const Position& pos, Color side, int ttMove, int ply, int depth, MoveList& moves) const;
+    void recordCutoff(Color side, int sq, int ply, int depth);
+    void searchLeaves(Position& pos, Color side, const MoveList& moves, int alpha, int beta, int& best, int& bestMove);
+    bool stopped() const { return owner.stopFlag.load(std::memory_order_relaxed); }
+
+    Searcher& owner;
+    int id;                   // 0 = main worker, owns the clock
+    bool useDeadline = false;
+    int killers[MAX_PLY][2] = {};
+    int history[2][NUM_SQUARES] = {};
+};
+
+void SearchWorker::orderMoves(const Position& pos, Color side, int ttMove, int ply, int depth, MoveList& moves) const {
+    int keys[NUM_SQUARES];
+    Color opp = opponentOf(side);
+    for (int i = 0; i < moves.size; ++i) {
+        int sq = moves[i];
+        int key;
+        if (sq == ttMove) key = 1 << 30;
+        else if (sq == killers[ply][0]) key = 1 << 29;
+        else if (sq == killers[ply][1]) key = (1 << 29) - 1;
+        else {
+            key = history[side][sq] + POSITION_WEIGHTS[sq] * 64;
+            if (depth >= MOBILITY_ORDER_DEPTH) {
+                Position child = pos;
+                child.makeMove(side, sq);
+                key -= popCount(child.legalMoves(opp)) * 1024;
+            }
+        }
+        // insertion sort, highest key first; lists are short
+        int j = i;
+        while (j > 0 && keys[j - 1] < key) { keys[j] = keys[j - 1]; moves.squares[j] = moves.squares[j - 1]; --j; }
+        keys[j] = key;
+        moves.squares[j] = static_cast<uint8_t>(sq);
+    }
+}
+
+void SearchWorker::recordCutoff(Color side, int sq, int ply, int depth) {
+    if (killers[ply][0] != sq) { killers[ply][1] = killers[ply][0]; killers[ply][0] = sq; }
+    history[side][sq] += depth * depth;
+    if (history[side][sq] > (1 << 20)) {
+        for (auto& row : history) for (int& h : row) h >>= 1;
+    }
+}
+
+// Children of a depth-1 node. The first (best-ordered) child alone settles most cut nodes; the rest
+// are scored together with evaluateBatch. Same visiting order and cutoff point as the plain loop.
+void SearchWorker::searchLeaves(Position& pos, Color side, const MoveList& moves, int alpha, int beta, int& best, int& bestMove) {
+    Color opp = opponentOf(side);
+    uint64_t flips = pos.makeMove(side, moves[0]);
+    ++nodes;
+    ++stats.leafEvals;
+    best = -evaluate(pos, opp);
+    bestMove = moves[0];
+    pos.undoMove(side, moves[0], flips);
+    if (best >= beta || moves.size == 1) return;
+    if (best > alpha) alpha = best;
+
+    uint64_t childOwn[NUM_SQUARES], childOpp[NUM_SQUARES];
+    int scores[NUM_SQUARES];
+    int count = moves.size - 1;
+    for (int i = 0; i < count; ++i) {
+        int sq = moves[i + 1];
+        uint64_t f = pos.flipsFor(side, sq);
+        childOwn[i] = pos.discs[opp] & ~f;
+        childOpp[i] = pos.discs[side] | f | squareBit(sq);
+    }
+    evaluateBatch(childOwn, childOpp, count, scores);
+    stats.leafEvals += count;
+    for (int i = 0; i < count; ++i) {
+        ++nodes;
+        int score = -scores[i];
+        if (score > best) {
+            best = score; bestMove = moves[i + 1];
+            if (best > alpha) { alpha = best; if (alpha >= beta) return; }
+        }
+    }
+}
+
+int SearchWorker::negamax(Position& pos, Color side, uint64_t hash, int depth, int ply, int alpha, int beta, bool passed) {
+    if ((++nodes & 1023) == 0 && id == 0 && useDeadline && Clock::now() >= owner.deadline)
+        owner.stopFlag.store(true, std::memory_order_relaxed);
+    if (stopped()) return 0;
+    if (depth == 0) { ++stats.leafEvals; return evaluate(pos, side); }
+
+    int alphaOrig = alpha;
+    TTHit hit;
+    int ttMove = -1, sym;
+    uint64_t key = owner.ttKey(pos, side, hash, sym);
+    ++ttStats.probes;
+    if (owner.tt.probe(key, hit)) {
+        ++ttStats.hits;
+        ttMove = hit.move < 0 ? -1 : untransformSquare(hit.move, sym);
+        if (hit.depth >= depth) {
+            if (hit.bound == Bound::EXACT) return hit.score;
+            if (hit.bound == Bound::LOWER && hit.score >= beta) return hit.score;
+            if (hit.bound == Bound::UPPER && hit.score <= alpha) return hit.score;
+        }
+    }
+
+    uint64_t mask = pos.legalMoves(side);
+    if (!mask) {
+        if (passed) return finalScore(pos, side);
+        // a pass does not consume depth; the passed flag stops it from recursing twice
+        return -negamax(pos, opponentOf(side), hash ^ zobristPassDelta(), depth, ply, -beta, -alpha, true);
+    }
+    MoveList moves(mask);
+    orderMoves(pos, side, ttMove, ply, depth, moves);
+
+    int best = -SCORE_INF, bestMove = -1;
+    if (depth == 1) {
+        searchLeaves(pos, side, moves, alpha, beta, best, bestMove);
+        if (best >= beta) {
+            recordCutoff(side, bestMove, ply, depth);
+            ++stats.cutoffs;
+            if (bestMove == moves[0]) ++stats.firstMoveCutoffs;
+        }
+    } else {
+        for (int sq : moves) {
+            uint64_t flips = pos.makeMove(side, sq);
+            int score = -negamax(pos, opponentOf(side), hash ^ zobristMoveDelta(side, sq, flips), depth - 1, ply + 1, -beta, -alpha, false);
+            pos.undoMove(side, sq, flips);
+            if (stopped()) return 0;
+            if (score > best) {
+                best = score; bestMove = sq;
+                if (best > alpha) {
+                    alpha = best;
+                    if (alpha >= beta) {
+                        recordCutoff(side, sq, ply, depth);
+                        ++stats.cutoffs;
+                        if (sq == moves[0]) ++stats.firstMoveCutoffs;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    Bound bound = best <= alphaOrig ? Bound::UPPER : best >= beta ? Bound::LOWER : Bound::EXACT;
+    ++ttStats.stores;
+    owner.tt.store(key, best, depth, bestMove < 0 ? -1 : transformSquare(bestMove, sym), bound);
+    return best;
+}
+
+void SearchWorker::run(const Position& rootPos, Color side, int maxDepth, int timeMs, Clock::time_point start) {
+    result = SearchResult();
+    ttStats = TTStats();
+    stats = SearchStats();
+    nodes = 0;
+    useDeadline = false;  // never abort depth 1, so there is always a searched move
+    for (auto& k : killers) k[0] = k[1] = -1;
+    for (auto& row : history) for (int& h : row) h >>= 2;  // keep some knowledge from the last move
+
+    Clock::duration lastElapsed = Clock::duration::zero();  // at the end of the previous iteration
+    Position pos = rootPos;
+    uint64_t rootHash = zobristHash(pos, side);
+    int rootSym;
+    uint64_t rootKey = owner.ttKey(pos, side, rootHash, rootSym);
+    MoveList rootMoves(pos.legalMoves(side));
+    TTHit hit;
+    int ttMove = owner.tt.probe(rootKey, hit) && hit.move >= 0 ? untransformSquare(hit.move, rootSym) : -1;
+    orderMoves(pos, side, ttMove, 0, MOBILITY_ORDER_DEPTH, rootMoves);
+    result.move = rootMoves[0];
+
+    // Lazy SMP: odd helpers skip ahead one ply so workers don't all finish the same iteration together
+    int firstDepth = (id & 1) && maxDepth > 1 ? 2 : 1;
+    for (int depth = firstDepth; depth <= maxDepth; ++depth) {
+        // try the previous iteration's best move first, keep the rest in their ordered positions
+        for (int i = 0; i < rootMoves.size; ++i) {
+            if (rootMoves.squares[i] == result.move) { std::rotate(rootMoves.squares, rootMoves.squares + i, rootMoves.squares + i + 1); break; }
+        }
+        int alpha = -SCORE_INF, bestScore = -SCORE_INF, bestMove = rootMoves[0];
+        for (int sq : rootMoves) {
+            uint64_t flips = pos.makeMove(side, sq);
+            int score = -negamax(pos, opponentOf(side), rootHash ^ zobristMoveDelta(side, sq, flips), depth - 1, 1, -SCORE_INF, -alpha, false);
+            pos.undoMove(side, sq, flips);
+            if (stopped()) break;
+            if (score > bestScore) { bestScore = score; bestMove = sq; }
+            if (score > alpha) alpha = score;
+        }
+        if (stopped()) break;
+        result.move = bestMove;
+        result.score = bestScore;
+        result.depth = depth;
+        owner.tt.store(rootKey, bestScore, depth, transformSquare(bestMove, rootSym), Bound::EXACT);
+
+        if (id == 0 && timeMs > 0) {
+            useDeadline = true;
+            // don't start what can't finish: predict the time to the end of the next iteration from
+            // how much the last one multiplied the elapsed time (the effective branching factor)
+            Clock::duration elapsed = Clock::now() - start;
+            double growth = MIN_ITERATION_GROWTH;
+            if (lastElapsed.count() > 0) growth = std::max(growth, double(elapsed.count()) / lastElapsed.count());
+            lastElapsed = elapsed;
+            if (start + std::chrono::duration_cast<Clock::duration>(elapsed * growth) >= owner.deadline) break;
+        }
+    }
+}
+
+// Follows best moves stored in the table from the root; stops at the first miss or illegal move.
+std::vector<int> Searcher::principalVariation(const Position& rootPos, Color side, int firstMove, int maxLength) const {
+    std::vector<int> pv;
+    Position pos = rootPos;
+    uint64_t hash = zobristHash(pos, side);
+    int move = firstMove;
+    while (static_cast<int>(pv.size()) < maxLength) {
+        uint64_t legal = pos.legalMoves(side);
+        if (!legal) {
+            if (!pos.legalMoves(opponentOf(side))) break;
+            pv.push_back(-1);
+            side = opponentOf(side);
+            hash ^= zobristPassDelta();
+            move = -1;
+            continue;
+        }
+        if (move < 0) {
+            TTHit hit;
+            int sym;
+            if (!tt.probe(ttKey(pos, side, hash, sym), hit) || hit.move < 0) break;
+            move = untransformSquare(hit.move, sym);
+        }
+        if (move < 0 || !(legal & squareBit(move))) break;
+        pv.push_back(move);
+        uint64_t flips = pos.makeMove(side, move);
+        hash ^= zobristMoveDelta(side, move, flips);
+        side = opponentOf(side);
+        move = -1;
+    }
+    return pv;
+}
+
+Searcher::Searcher() {
+    setThreads(1);
+    endgame.setHashBytes(tt.sizeBytes() / 4);
+}
+Searcher::~Searcher() = default;
+
+void Searcher::setThreads(int count) {
+    if (count < 1) count = 1;
+    while (static_cast<int>(workers.size()) > count) workers.pop_back();
+    while (static_cast<int>(workers.size()) < count)
+        workers.emplace_back(new SearchWorker(*this, static_cast<int>(workers.size())));
+}
+
+void Searcher::clearHash() {
+    tt.clear();
+    for (auto& w : workers) w->clearHistory();
+}
+
+SearchResult Searcher::search(const Position& rootPos, Color side, const SearchLimits& limits) {
+    SearchResult result;
+    if (!rootPos.legalMoves(side)) return result;
+
+    Clock::time_point start = Clock::now();
+    deadline = start + std::chrono::milliseconds(limits.timeMs);
+    symmetryDiscs = limits.symmetryDiscs;
+    stopFlag.store(false);
+    if (stopRequested.load()) stopFlag.store(true);  // stop() raced with the reset above
+    tt.newSearch();
+
+    if (rootPos.emptyCount() <= limits.endgameEmpties) {
+        endgame.reset();
+        if (limits.timeMs > 0) endgame.setDeadline(start + std::chrono::milliseconds(limits.timeMs) / 2);
+        int move;
+        int score = endgame.solve(rootPos, side, move);
+        if (!endgame.aborted()) {
+            result.move = move;
+            result.score = score * DISC_SCORE;
+            result.depth = rootPos.emptyCount();
+            result.exact = true;
+            result.nodes = endgame.nodes;
+            result.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            result.stats.pv.push_back(move);
+            if (result.depth > 0) result.stats.branchingFactor = std::pow(double(result.nodes), 1.0 / result.depth);
+            return result;
+        }
+    }
+
+    int maxDepth = limits.maxDepth < rootPos.emptyCount() ? limits.maxDepth : rootPos.emptyCount();
+    if (maxDepth < 1) maxDepth = 1;
+
+    // iteration timing starts here, after any aborted endgame solve
+    Clock::time_point searchStart = Clock::now();
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < workers.size(); ++i) {
+        SearchWorker* w = workers[i].get();
+        helpers.emplace_back([=, &rootPos] { w->run(rootPos, side, maxDepth, limits.timeMs, searchStart); });
+    }
+    workers[0]->run(rootPos, side, maxDepth, limits.timeMs, searchStart);
+    stopFlag.store(true);  // main worker is done: stop helpers still in a deeper iteration
+    for (std::thread& t : helpers) t.join();
+
+    result = workers[0]->result;
+    for (auto& w : workers) {
+        if (w->result.depth > result.depth) result = w->result;
+    }
+    for (auto& w : workers) {
+        result.nodes += w->nodes;
+        ttCounters += w->ttStats;
+        result.stats += w->stats;
+        result.stats.ttProbes += w->ttStats.probes;
+        result.stats.ttHits += w->ttStats.hits;
+    }
+    if (result.depth > 0) result.stats.branchingFactor = std::pow(double(result.nodes), 1.0 / result.depth);
+    result.stats.pv = principalVariation(rootPos, side, result.move, result.depth);
+    result.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return result;
+}
+
+int scoreAfterMove(Searcher& searcher, const Position& child, Color mover, const SearchLimits& limits) {
+    Color opponent = opponentOf(mover);
+    if (child.legalMoves(opponent)) return -searcher.search(child, opponent, limits).score;
+    if (child.legalMoves(mover)) return searcher.search(child, mover, limits).score;
+    return finalScore(child, mover);
+}
+
+} // namespace OthelloEngine
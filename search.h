@@ -0,0 +1,124 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "bitboard.h"
+#include "endgame.h"
+#include "transposition_table.h"
+
+namespace OthelloEngine {
+
+class SearchWorker;
+
+struct SearchLimits {
+    int maxDepth = 60;  // plies; also capped by the number of empty squares
+    int timeMs = 200;   // wall-clock budget, <= 0 means depth-limited only
+    int endgameEmpties = 16;  // at or below this many empties, solve exactly (within half of timeMs); < 0 disables
+    int symmetryDiscs = 12;   // positions with at most this many discs share TT entries with their mirror images; 0 disables
+};
+
+// Work done by one search, summed over all threads.
+struct SearchStats {
+    unsigned long long leafEvals = 0;         // static evaluations
+    unsigned long long cutoffs = 0;           // beta cutoffs at interior nodes
+    unsigned long long firstMoveCutoffs = 0;  // cutoffs caused by the first move tried (ordering quality)
+    unsigned long long ttProbes = 0;
+    unsigned long long ttHits = 0;
+    double branchingFactor = 0;  // effective: nodes^(1/depth)
+    std::vector<int> pv;         // principal variation from the root, read back from the TT; -1 = pass
+
+    double firstMoveCutoffRate() const { return cutoffs ? double(firstMoveCutoffs) / cutoffs : 0; }
+    double ttHitRate() const { return ttProbes ? double(ttHits) / ttProbes : 0; }
+    SearchStats& operator+=(const SearchStats& o) {
+        leafEvals += o.leafEvals; cutoffs += o.cutoffs; firstMoveCutoffs += o.firstMoveCutoffs;
+        ttProbes += o.ttProbes; ttHits += o.ttHits;
+        return *this;
+    }
+};
+
+struct SearchResult {
+    int move = -1;   // square index, -1 when the side to move has to pass
+    int score = 0;   // from the mover's point of view
+    int depth = 0;   // deepest fully completed iteration
+    bool exact = false;  // solved to the end: score is the final disc margin * DISC_SCORE
+    unsigned long long nodes = 0;  // summed over all threads
+    double elapsedMs = 0;
+    SearchStats stats;  // only nodes are counted for exact endgame solves; pv is then just the move
+
+    double nodesPerSec() const { return elapsedMs > 0 ? nodes * 1000.0 / elapsedMs : 0; }
+};
+
+// Negamax alpha-beta with iterative deepening. The result always comes from the
+// deepest iteration that finished inside the time budget (depth 1 always finishes).
+// Children are ordered TT move, killers, then history + square priority, with
+// fastest-first (fewest opponent replies) added at depth >= MOBILITY_ORDER_DEPTH.
+//
+// With setThreads(n > 1) the search runs Lazy SMP: n workers search the same root
+// concurrently, sharing only the lock-free transposition table; helpers start at
+// staggered depths so they fill the table ahead of the main worker. The deepest
+// completed iteration over all workers wins.
+//
+// Roots with at most SearchLimits::endgameEmpties empty squares are handed to the
+// exact EndgameSolver instead (single-threaded, result.exact is set). With a time
+// budget the solver gets half of it; if it cannot finish, the iterative-deepening
+// search runs on the remaining half.
+class Searcher {
+public:
+    Searcher();
+    ~Searcher();
+
+    SearchResult search(const Position& pos, Color side, const SearchLimits& limits);
+
+    // Callable from any thread: the running search returns promptly with its deepest completed
+    // iteration (depth 0, first ordered move, if none completed). A stop issued just before search()
+    // starts also applies to it; the request holds until clearStop(), called once the search returned.
+    void stop() { stopRequested.store(true); stopFlag.store(true); }
+    void clearStop() { stopRequested.store(false); }
+
+    // Transposition table budget in MB (power-of-two rounded down); clears the table. The endgame
+    // solver's own table comes on top, sized to a quarter of the transposition table (at most
+    // 3 MB at the default 16 MB).
+    void setHashSize(size_t megabytes) { tt.resize(megabytes); endgame.setHashBytes(tt.sizeBytes() / 4); }
+    // Also forgets the move-ordering history, so a fixed-depth search after it is reproducible.
+    void clearHash();
+    const TranspositionTable& table() const { return tt; }
+    // Counters summed over all workers and searches since the last reset.
+    const TTStats& ttStats() const { return ttCounters; }
+    void resetStats() { ttCounters = TTStats(); }
+
+    // Number of search threads including the calling thread; values < 1 are treated as 1.
+    void setThreads(int count);
+    int threadCount() const { return static_cast<int>(workers.size()); }
+
+private:
+    friend class SearchWorker;
+
+    std::vector<int> principalVariation(const Position& rootPos, Color side, int firstMove, int maxLength) const;
+    // TT key of a node: `hash` itself, or canonicalHash early in the game (see SearchLimits::symmetryDiscs),
+    // with `sym` set to the symmetry stored moves are expressed in (0 = as played).
+    uint64_t ttKey(const Position& pos, Color side, uint64_t hash, int& sym) const {
+        sym = 0;
+        return popCount(pos.occupied()) <= symmetryDiscs ? canonicalHash(pos, side, &sym) : hash;
+    }
+
+    TranspositionTable tt;
+    TTStats ttCounters;
+    std::vector<std::unique_ptr<SearchWorker>> workers;
+    std::atomic<bool> stopFlag{false};       // set by stop() or the main worker's deadline, cleared per search
+    std::atomic<bool> stopRequested{false};  // external stop, survives the reset at the start of search()
+    std::chrono::steady_clock::time_point deadline;
+    int symmetryDiscs = 0;  // SearchLimits::symmetryDiscs of the running search
+    EndgameSolver endgame{&stopFlag};
+};
+
+// Score for `mover` of `child`, the position its move just reached, searched with `limits`: the
+// opponent's search negated, `mover`'s own search when the opponent has to pass, or the final
+// margin when neither side can move (Searcher::search itself returns 0 without a legal move).
+int scoreAfterMove(Searcher& searcher, const Position& child, Color mover, const SearchLimits& limits);
+
+} // namespace OthelloEngine
+
+#endif
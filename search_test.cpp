@@ -0,0 +1,103 @@
+#include <iostream>
+#include <string>
+
+#include "bitboard.h"
+#include "evaluation.h"
+#include "search.h"
+#include "transposition_table.h"
+
+// Engine regression tests, no SFML dependency; run by ctest. Exit code 1 on the first failure.
+
+using namespace OthelloEngine;
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cerr << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+// Board full of white discs except the listed empty and black squares.
+Position whiteBoard(std::initializer_list<const char*> empty, std::initializer_list<const char*> black) {
+    Position pos;
+    pos.discs[BLACK] = 0;
+    pos.discs[WHITE] = ~0ULL;
+    for (const char* s : empty) pos.discs[WHITE] &= ~squareBit(parseSquare(s));
+    for (const char* s : black) {
+        pos.discs[WHITE] &= ~squareBit(parseSquare(s));
+        pos.discs[BLACK] |= squareBit(parseSquare(s));
+    }
+    return pos;
+}
+
+// The played move is scored on its child position, which may leave the opponent without a move
+// (analysis of a move that forces a pass) or end the game.
+void testScoreAfterMove() {
+    Searcher searcher;
+    SearchLimits exact;
+    exact.timeMs = 0;
+    SearchLimits shallow = exact;
+    shallow.endgameEmpties = -1;
+    shallow.maxDepth = 2;
+
+    // black a1 flips b1 and fills the board
+    Position end = whiteBoard({"a1"}, {"c1"});
+    end.makeMove(BLACK, parseSquare("a1"));
+    check(!end.legalMoves(BLACK) && !end.legalMoves(WHITE), "game-ending move: no moves left");
+    int expected = finalScore(end, BLACK);
+    check(scoreAfterMove(searcher, end, BLACK, exact) == expected, "game-ending move, exact");
+    check(scoreAfterMove(searcher, end, BLACK, shallow) == expected, "game-ending move, depth-limited");
+
+    // black a1 leaves white without a move; black then plays h8 to end the game
+    Position pass = whiteBoard({"a1", "h8"}, {"c1", "f8"});
+    pass.makeMove(BLACK, parseSquare("a1"));
+    check(!pass.legalMoves(WHITE) && pass.legalMoves(BLACK) == squareBit(parseSquare("h8")), "forced pass: setup");
+    Position final = pass;
+    final.makeMove(BLACK, parseSquare("h8"));
+    expected = finalScore(final, BLACK);
+    check(expected != 0, "forced pass: nonzero margin");
+    check(scoreAfterMove(searcher, pass, BLACK, exact) == expected, "forced pass, exact");
+    check(scoreAfterMove(searcher, pass, BLACK, shallow) == expected, "forced pass, depth-limited");
+
+    // an ordinary reply is the opponent's score negated
+    Position start = Position::initial();
+    start.makeMove(BLACK, parseSquare("f5"));
+    SearchLimits depth4 = shallow;
+    depth4.maxDepth = 4;
+    searcher.clearHash();
+    int reply = searcher.search(start, WHITE, depth4).score;
+    searcher.clearHash();
+    check(scoreAfterMove(searcher, start, BLACK, depth4) == -reply, "ordinary move");
+}
+
+// Sizes round down to a power of two and stay within [1 MB, MAX_MEGABYTES].
+void testHashResize() {
+    TranspositionTable tt(1);
+    check(tt.sizeBytes() == size_t(1) << 20, "tt: 1 MB");
+    tt.resize(0);
+    check(tt.sizeBytes() == size_t(1) << 20, "tt: 0 MB clamps to 1 MB");
+    tt.resize(3);
+    check(tt.sizeBytes() == size_t(2) << 20, "tt: 3 MB rounds down to 2 MB");
+    tt.resize(16);
+    check(tt.sizeBytes() == size_t(16) << 20, "tt: 16 MB");
+
+    tt.store(12345, 7, 5, 19, Bound::EXACT);
+    TTHit hit;
+    check(tt.probe(12345, hit) && hit.score == 7 && hit.move == 19, "tt: probe after store");
+    tt.resize(8);
+    check(!tt.probe(12345, hit), "tt: resize clears");
+}
+
+} // namespace
+
+int main() {
+    testScoreAfterMove();
+    testHashResize();
+    if (failures) return 1;
+    std::cout << "all tests passed\n";
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ai_player.h"
+#include "bitboard.h"
+#include "cli_args.h"
+#include "game_record.h"
+#include "transposition_table.h"
+
+// Headless engine-vs-engine matches, no SFML dependency.
+// Usage:
+//   reversi_selfplay [--games N] [--threads N] [--opening-plies N] [--seed S] [--a SPEC] [--b SPEC]
+//                    [--record FILE]
+//   SPEC = easy | medium | hard[:ms=T][:depth=D][:hash=MB][:endgame=E][:sym=N]   (defaults: A hard:ms=50, B medium)
+// Games are played in pairs from the same random opening with colours swapped, spread over a pool
+// of worker threads; each worker owns its own pair of engines. Results are from engine A's side.
+// Openings are --opening-plies (0..50, default 6) random moves that leave the game unfinished.
+// --record appends every game, opening included, to a game record file (game_record.h).
+
+using namespace OthelloEngine;
+
+namespace {
+
+struct EngineSpec {
+    std::string text;
+    AIDifficulty level = AIDifficulty::MEDIUM;
+    SearchLimits limits;
+    size_t hashMb = 8;  // per engine per worker thread
+};
+
+bool parseSpec(const std::string& text, EngineSpec& spec) {
+    spec = EngineSpec();
+    spec.text = text;
+    std::stringstream in(text);
+    std::string part;
+    std::getline(in, part, ':');
+    if (part == "easy") spec.level = AIDifficulty::EASY;
+    else if (part == "medium") spec.level = AIDifficulty::MEDIUM;
+    else if (part == "hard") spec.level = AIDifficulty::HARD;
+    else return false;
+    bool depthGiven = false;
+    while (std::getline(in, part, ':')) {
+        size_t eq = part.find('=');
+        if (eq == std::string::npos) return false;
+        std::string key = part.substr(0, eq), value = part.substr(eq + 1);
+        bool ok;
+        if (key == "ms") ok = parseNumber(value, 0, 3600000, spec.limits.timeMs);
+        else if (key == "depth") ok = depthGiven = parseNumber(value, 1, 60, spec.limits.maxDepth);
+        else if (key == "hash") ok = parseNumber(value, size_t(1), TranspositionTable::MAX_MEGABYTES, spec.hashMb);
+        else if (key == "endgame") ok = parseNumber(value, -1, 60, spec.limits.endgameEmpties);
+        else if (key == "sym") ok = parseNumber(value, 0, 64, spec.limits.symmetryDiscs);
+        else return false;
+        if (!ok) return false;
+    }
+    return spec.limits.timeMs > 0 || depthGiven;  // ms=0 searches by depth only
+}
+
+struct Opening {
+    Position pos;
+    Color side;
+    std::vector<int> moves;  // from the start position, -1 = pass
+};
+
+// Longest random opening accepted: openings that end the game are redrawn, and past this many plies
+// too many random games are over (at 60 none is left), so the redraw loop would not terminate.
+const int MAX_OPENING_PLIES = 50;
+
+// Random legal moves from the start position, reproducible from (seed, index). 0 <= plies <= MAX_OPENING_PLIES.
+Opening randomOpening(unsigned seed, int index, int plies) {
+    std::mt19937 rng(seed * 1000003u + static_cast<unsigned>(index));
+    while (true) {
+        Opening o{Position::initial(), BLACK, {}};
+        int played = 0;
+        while (played < plies) {
+            uint64_t moves = o.pos.legalMoves(o.side);
+            if (!moves) {
+                o.side = opponentOf(o.side);
+                if (!o.pos.legalMoves(o.side)) break;
+                o.moves.push_back(-1);
+                continue;
+            }
+            MoveList list(moves);
+            o.moves.push_back(list[std::uniform_int_distribution<int>(0, list.size - 1)(rng)]);
+            o.pos.makeMove(o.side, o.moves.back());
+            o.side = opponentOf(o.side);
+            ++played;
+        }
+        if (played == plies && (o.pos.legalMoves(o.side) || o.pos.legalMoves(opponentOf(o.side)))) return o;
+    }
+}
+
+// Plays the game out; returns the final disc margin for `black`. `moves` gets the whole game.
+int playGame(const Opening& opening, AIPlayer& black, AIPlayer& white, std::vector<int>& moves) {
+    Position pos = opening.pos;
+    Color side = opening.side;
+    moves = opening.moves;
+    while (true) {
+        if (!pos.legalMoves(side)) {
+            side = opponentOf(side);
+            if (!pos.legalMoves(side)) break;
+            moves.push_back(-1);
+        }
+        AIPlayer& mover = side == BLACK ? black : white;
+        moves.push_back(mover.chooseMove(pos, side));
+        pos.makeMove(side, moves.back());
+        side = opponentOf(side);
+    }
+    return pos.count(BLACK) - pos.count(WHITE);
+}
+
+struct MatchStats {
+    int wins[2] = {0, 0}, draws[2] = {0, 0}, losses[2] = {0, 0};  // for A, indexed by A's colour
+    long long marginSum = 0;
+
+    int games() const { return wins[0] + wins[1] + draws[0] + draws[1] + losses[0] + losses[1]; }
+    void record(Color aColor, int aMargin) {
+        if (aMargin > 0) ++wins[aColor]; else if (aMargin < 0) ++losses[aColor]; else ++draws[aColor];
+        marginSum += aMargin;
+    }
+};
+
+double eloFromScore(double score) {
+    score = std::min(std::max(score, 0.001), 0.999);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+void printReport(const MatchStats& s, const EngineSpec& a, const EngineSpec& b, int threads, double seconds) {
+    int n = s.games();
+    int w = s.wins[0] + s.wins[1], d = s.draws[0] + s.draws[1], l = s.losses[0] + s.losses[1];
+    double score = n ? (w + 0.5 * d) / n : 0.5;
+    // per-game variance of the score (1 / 0.5 / 0), normal approximation for the 95% interval
+    double var = n ? (w * (1 - score) * (1 - score) + d * (0.5 - score) * (0.5 - score) + l * score * score) / n : 0;
+    double margin = 1.96 * std::sqrt(var / std::max(n, 1));
+
+    std::cout << std::fixed << std::showpos;
+    std::cout << "A: " << a.text << "   B: " << b.text << '\n';
+    std::cout << std::noshowpos << "games " << n << ", threads " << threads << ", " << std::setprecision(1) << seconds
+              << " s, " << std::setprecision(2) << (seconds > 0 ? n / seconds : 0) << " games/sec\n";
+    std::cout << "A wins " << w << "  draws " << d << "  losses " << l << "   score " << std::setprecision(1)
+              << 100 * score << "%\n";
+    std::cout << "  as black " << s.wins[BLACK] << "-" << s.draws[BLACK] << "-" << s.losses[BLACK]
+              << "   as white " << s.wins[WHITE] << "-" << s.draws[WHITE] << "-" << s.losses[WHITE] << '\n';
+    std::cout << std::showpos << "Elo (A - B): " << eloFromScore(score) << "   95% CI [" << eloFromScore(score - margin)
+              << ", " << eloFromScore(score + margin) << "]\n";
+    std::cout << "avg disc margin: " << (n ? double(s.marginSum) / n : 0.0) << std::noshowpos << '\n';
+}
+
+int usage() {
+    std::cerr << "usage: reversi_selfplay [--games N] [--threads N] [--opening-plies N] [--seed S] [--a SPEC] [--b SPEC]\n"
+                 "                        [--record FILE]\n"
+                 "  SPEC = easy | medium | hard[:ms=T][:depth=D][:hash=MB][:endgame=E][:sym=N]\n"
+                 "  --opening-plies 0-" << MAX_OPENING_PLIES << "; in SPEC ms=0 (depth only) needs depth=D, hash=MB is 1-"
+              << TranspositionTable::MAX_MEGABYTES << '\n';
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int games = 100, threads = static_cast<int>(std::thread::hardware_concurrency()), openingPlies = 6;
+    unsigned seed = 1;
+    EngineSpec specA, specB;
+    std::string recordPath;
+    parseSpec("hard:ms=50", specA);
+    parseSpec("medium", specB);
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 == argc) return usage();  // every option takes a value
+        std::string opt = argv[i], val = argv[i + 1];
+        bool ok = true;
+        if (opt == "--games") ok = parseNumber(val, 1, 100000000, games);
+        else if (opt == "--threads") ok = parseNumber(val, 1, 1024, threads);
+        else if (opt == "--opening-plies") ok = parseNumber(val, 0, MAX_OPENING_PLIES, openingPlies);
+        else if (opt == "--seed") ok = parseNumber(val, 0u, 4294967295u, seed);
+        else if (opt == "--record") recordPath = val;
+        else if (opt == "--a" || opt == "--b") {
+            if (!parseSpec(val, opt == "--a" ? specA : specB)) { std::cerr << "bad engine spec: " << val << '\n'; return usage(); }
+        } else {
+            return usage();
+        }
+        if (!ok) { std::cerr << "bad value for " << opt << ": " << val << '\n'; return usage(); }
+    }
+    if (threads < 1) threads = 1;
+    int pairs = (std::max(games, 2) + 1) / 2;  // colour-swapped pairs, so the game count is rounded up to even
+    threads = std::min(threads, pairs);
+
+    GameRecordWriter record;
+    if (!recordPath.empty() && !record.open(recordPath, true)) { std::cerr << "cannot write " << recordPath << '\n'; return 1; }
+
+    MatchStats stats;
+    std::mutex statsMutex;  // also guards record
+    std::atomic<int> nextPair{0};
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&](int id) {
+        AIPlayer a(specA.level, seed * 2654435761u + 2 * id), b(specB.level, seed * 2654435761u + 2 * id + 1);
+        a.setSearchLimits(specA.limits); a.setHashSize(specA.hashMb);
+        b.setSearchLimits(specB.limits); b.setHashSize(specB.hashMb);
+        for (int k; (k = nextPair.fetch_add(1)) < pairs; ) {
+            Opening opening = randomOpening(seed, k, openingPlies);
+            int results[2];
+            std::vector<int> moves[2];
+            for (int aColor = BLACK; aColor <= WHITE; ++aColor) {
+                a.newGame(); b.newGame();
+                int blackMargin = aColor == BLACK ? playGame(opening, a, b, moves[aColor])
+                                                  : playGame(opening, b, a, moves[aColor]);
+                results[aColor] = aColor == BLACK ? blackMargin : -blackMargin;
+            }
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats.record(BLACK, results[BLACK]);
+            stats.record(WHITE, results[WHITE]);
+            if (record.isOpen()) {
+                record.write(moves[BLACK], true, results[BLACK], "black=" + specA.text + " white=" + specB.text);
+                record.write(moves[WHITE], true, -results[WHITE], "black=" + specB.text + " white=" + specA.text);
+            }
+            std::cerr << "\r" << stats.games() << "/" << 2 * pairs << " games" << std::flush;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+    for (std::thread& t : pool) t.join();
+    std::cerr << '\n';
+
+    if (!record.close()) { std::cerr << "cannot write " << recordPath << '\n'; return 1; }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printReport(stats, specA, specB, threads, seconds);
+    return 0;
+}
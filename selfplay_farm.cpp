@@ -0,0 +1,105 @@
+#include "selfplay_farm.h"
+#include <algorithm>
+#include <random>
+
+namespace OthelloEngine {
+
+SelfPlayFarm::SelfPlayFarm(const FarmOptions& opts) : options(opts) {
+    options.boards = std::max(options.boards, 1);
+    slots.reset(new Slot[options.boards]);
+}
+
+void SelfPlayFarm::start() {
+    if (running()) return;
+    stopping.store(false);
+    int threads = options.threads;
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    threads = std::min(std::max(threads, 1), options.boards);
+    auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.boards; ++i) {
+        // finished boards start a new game on their first turn
+        FarmBoard b;
+        b.finished = true;
+        publish(slots[i], b);
+        slots[i].nextAt = now;
+    }
+    for (int t = 0; t < threads; ++t) workers.emplace_back(&SelfPlayFarm::work, this, t, threads);
+}
+
+void SelfPlayFarm::stop() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) t.join();
+    workers.clear();
+}
+
+FarmBoard SelfPlayFarm::board(int index) const {
+    std::lock_guard<std::mutex> guard(slots[index].lock);
+    return slots[index].board;
+}
+
+void SelfPlayFarm::publish(Slot& slot, const FarmBoard& b) {
+    {
+        std::lock_guard<std::mutex> guard(slot.lock);
+        slot.board = b;
+    }
+    changes.fetch_add(1);
+}
+
+void SelfPlayFarm::work(int id, int threads) {
+    unsigned seed = options.seed * 2654435761u + 2 * static_cast<unsigned>(id);
+    AIPlayer black(options.level, seed), white(options.level, seed + 1);
+    for (AIPlayer* p : {&black, &white}) {
+        p->setSearchLimits(options.limits);
+        p->setHashSize(options.hashMb);
+    }
+    std::mt19937 rng(seed);
+    typedef std::chrono::steady_clock Clock;
+    // after a move: the side to move passes if it has to, and the game ends when neither side can move
+    auto settle = [this](FarmBoard& b) {
+        if (!b.pos.legalMoves(b.side)) b.side = opponentOf(b.side);  // pass
+        if (!b.pos.legalMoves(b.side)) {
+            b.finished = true;
+            ++b.gamesPlayed;
+            int margin = b.pos.count(BLACK) - b.pos.count(WHITE);
+            if (margin == 0) drawn.fetch_add(1);
+            else wins[margin > 0 ? BLACK : WHITE].fetch_add(1);
+        }
+    };
+    while (!stopping.load()) {
+        Clock::time_point now = Clock::now(), wakeAt = now + std::chrono::milliseconds(options.moveIntervalMs);
+        for (int i = id; i < options.boards && !stopping.load(); i += threads) {
+            Slot& slot = slots[i];
+            if (slot.nextAt > now) { wakeAt = std::min(wakeAt, slot.nextAt); continue; }
+            FarmBoard b = slot.board;  // only this worker writes it
+            if (b.finished) {
+                // new game from a random opening
+                unsigned played = b.gamesPlayed;
+                b = FarmBoard();
+                b.gamesPlayed = played;
+                for (int ply = 0; ply < options.openingPlies && !b.finished; ++ply) {
+                    MoveList moves(b.pos.legalMoves(b.side));
+                    b.lastMove = moves[std::uniform_int_distribution<int>(0, moves.size - 1)(rng)];
+                    b.pos.makeMove(b.side, b.lastMove);
+                    b.side = opponentOf(b.side);
+                    settle(b);
+                }
+            } else {
+                b.lastMove = (b.side == BLACK ? black : white).chooseMove(b.pos, b.side);
+                b.pos.makeMove(b.side, b.lastMove);
+                b.side = opponentOf(b.side);
+                settle(b);
+            }
+            publish(slot, b);
+            slot.nextAt = Clock::now() + std::chrono::milliseconds(b.finished ? options.restartDelayMs : options.moveIntervalMs);
+            wakeAt = std::min(wakeAt, slot.nextAt);
+        }
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait_until(guard, wakeAt, [this] { return stopping.load(); });
+    }
+}
+
+} // namespace OthelloEngine
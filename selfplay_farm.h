@@ -0,0 +1,86 @@
+#ifndef SELFPLAY_FARM_H
+#define SELFPLAY_FARM_H
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ai_player.h"
+#include "bitboard.h"
+
+namespace OthelloEngine {
+
+struct FarmOptions {
+    FarmOptions() { limits.timeMs = 50; limits.endgameEmpties = 12; }
+
+    int boards = 16;
+    int threads = 0;        // <= 0: one less than the hardware threads, at least 1
+    AIDifficulty level = AIDifficulty::HARD;  // both sides
+    SearchLimits limits;    // HARD only; short by default so many boards keep moving
+    size_t hashMb = 4;      // per engine
+    int openingPlies = 4;   // random moves before the engines take over
+    int moveIntervalMs = 250;   // at least this long between two moves on one board
+    int restartDelayMs = 2000;  // a finished board stays on screen this long
+    unsigned seed = 1;
+};
+
+// Snapshot of one board.
+struct FarmBoard {
+    Position pos = Position::initial();
+    Color side = BLACK;      // to move
+    bool finished = false;
+    int lastMove = -1;
+    unsigned gamesPlayed = 0;  // finished games on this board
+};
+
+// Engine-vs-engine games played continuously on a pool of background threads, for watching a
+// self-play farm. Each board belongs to one worker, which plays one move at a time on each of its
+// boards in turn, so all boards advance at a similar pace. Readers take snapshots at any time.
+class SelfPlayFarm {
+public:
+    explicit SelfPlayFarm(const FarmOptions& options = FarmOptions());
+    ~SelfPlayFarm() { stop(); }
+    SelfPlayFarm(const SelfPlayFarm&) = delete;
+    SelfPlayFarm& operator=(const SelfPlayFarm&) = delete;
+
+    void start();
+    // Stops and joins the workers, after any move being searched.
+    void stop();
+    bool running() const { return !workers.empty(); }
+
+    int boardCount() const { return options.boards; }
+    FarmBoard board(int index) const;
+    // Bumped on every change to any board: redraw when it differs from the last value seen.
+    unsigned long long version() const { return changes.load(); }
+    // Finished games over all boards.
+    unsigned blackWins() const { return wins[BLACK].load(); }
+    unsigned whiteWins() const { return wins[WHITE].load(); }
+    unsigned draws() const { return drawn.load(); }
+
+private:
+    struct Slot {
+        mutable std::mutex lock;  // guards board; only the owning worker writes it
+        FarmBoard board;
+        std::chrono::steady_clock::time_point nextAt;
+    };
+
+    void work(int id, int threads);
+    void publish(Slot& slot, const FarmBoard& b);
+
+    FarmOptions options;
+    std::unique_ptr<Slot[]> slots;
+    std::vector<std::thread> workers;
+    std::atomic<bool> stopping{false};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::atomic<unsigned long long> changes{0};
+    std::atomic<unsigned> wins[2] = {{0}, {0}};
+    std::atomic<unsigned> drawn{0};
+};
+
+} // namespace OthelloEngine
+
+#endif
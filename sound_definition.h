@@ -10,7 +10,8 @@
 	 GAME_START,
 	 GAME_END,
 	 PLAYER_SWITCH,
-	 BUTTON_CLICK
+	 BUTTON_CLICK,
+	 COUNT  // number of sound types
  };
 
  struct SoundConfig {
@@ -0,0 +1,129 @@
+#include "transposition_table.h"
+#include <algorithm>
+
+namespace OthelloEngine {
+
+namespace {
+
+struct ZobristKeys {
+    uint64_t square[2][NUM_SQUARES];
+    uint64_t flip[NUM_SQUARES];  // square[BLACK][sq] ^ square[WHITE][sq]
+    uint64_t side;
+
+    ZobristKeys() {
+        uint64_t s = 0x9E3779B97F4A7C15ULL;
+        auto next = [&s]() {  // splitmix64, fixed seed so hashes are stable across runs
+            uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        };
+        for (int c = 0; c < 2; ++c)
+            for (int sq = 0; sq < NUM_SQUARES; ++sq) square[c][sq] = next();
+        for (int sq = 0; sq < NUM_SQUARES; ++sq) flip[sq] = square[BLACK][sq] ^ square[WHITE][sq];
+        side = next();
+    }
+};
+
+const ZobristKeys KEYS;
+
+inline uint64_t packData(int score, int depth, int move, Bound bound, uint8_t gen) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(score))
+         | static_cast<uint64_t>(static_cast<uint8_t>(move)) << 32
+         | static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 40
+         | static_cast<uint64_t>(bound) << 48
+         | static_cast<uint64_t>(gen) << 56;
+}
+inline int dataScore(uint64_t d) { return static_cast<int32_t>(static_cast<uint32_t>(d)); }
+inline int dataMove(uint64_t d) { int m = static_cast<uint8_t>(d >> 32); return m == 0xFF ? -1 : m; }
+inline int dataDepth(uint64_t d) { return static_cast<uint8_t>(d >> 40); }
+inline Bound dataBound(uint64_t d) { return static_cast<Bound>(static_cast<uint8_t>(d >> 48)); }
+inline uint8_t dataGeneration(uint64_t d) { return static_cast<uint8_t>(d >> 56); }
+
+} // namespace
+
+uint64_t zobristHash(const Position& pos, Color side) {
+    uint64_t h = side == WHITE ? KEYS.side : 0;
+    for (uint64_t b = pos.discs[BLACK]; b; ) h ^= KEYS.square[BLACK][popLowestSquare(b)];
+    for (uint64_t b = pos.discs[WHITE]; b; ) h ^= KEYS.square[WHITE][popLowestSquare(b)];
+    return h;
+}
+
+uint64_t zobristMoveDelta(Color side, int sq, uint64_t flips) {
+    uint64_t h = KEYS.square[side][sq] ^ KEYS.side;
+    while (flips) h ^= KEYS.flip[popLowestSquare(flips)];
+    return h;
+}
+
+uint64_t zobristPassDelta() { return KEYS.side; }
+
+uint64_t canonicalHash(const Position& pos, Color side, int* sym) {
+    Position c;
+    c.discs[BLACK] = pos.discs[side];
+    c.discs[WHITE] = pos.discs[opponentOf(side)];
+    int s = canonicalize(c.discs[BLACK], c.discs[WHITE]);
+    if (sym) *sym = s;
+    return zobristHash(c, BLACK);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    megabytes = std::min(std::max(megabytes, size_t(1)), MAX_MEGABYTES);
+    size_t bytes = megabytes << 20;
+    size_t count = 1;
+    while (count <= bytes / (2 * sizeof(Bucket))) count *= 2;
+    buckets.reset(new Bucket[count]);
+    bucketCount = count;
+    mask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    const uint64_t empty = packData(0, 0, -1, Bound::NONE, 0);
+    for (size_t i = 0; i < bucketCount; ++i) {
+        for (Entry& e : buckets[i].entries) {
+            e.data.store(empty, std::memory_order_relaxed);
+            e.check.store(empty, std::memory_order_relaxed);  // key 0
+        }
+    }
+    generation = 0;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTHit& out) const {
+    const Bucket& b = buckets[key & mask];
+    for (const Entry& e : b.entries) {
+        uint64_t data = e.data.load(std::memory_order_relaxed);
+        if ((e.check.load(std::memory_order_relaxed) ^ data) != key || dataBound(data) == Bound::NONE) continue;
+        out.score = dataScore(data);
+        out.depth = dataDepth(data);
+        out.move = dataMove(data);
+        out.bound = dataBound(data);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int score, int depth, int move, Bound bound) {
+    Bucket& b = buckets[key & mask];
+    Entry* victim = &b.entries[0];
+    int victimValue = 1 << 30;
+    for (Entry& e : b.entries) {
+        uint64_t data = e.data.load(std::memory_order_relaxed);
+        if ((e.check.load(std::memory_order_relaxed) ^ data) == key) {
+            // keep a deeper result from this search unless the new one is exact
+            if (dataGeneration(data) == generation && dataDepth(data) > depth && bound != Bound::EXACT) return;
+            if (move < 0) move = dataMove(data);
+            victim = &e;
+            break;
+        }
+        // stale generations first, then shallowest
+        int age = static_cast<uint8_t>(generation - dataGeneration(data));
+        int value = dataDepth(data) - age * 64;
+        if (dataBound(data) == Bound::NONE) value = -(1 << 30);
+        if (value < victimValue) { victimValue = value; victim = &e; }
+    }
+    uint64_t data = packData(score, depth, move, bound, generation);
+    victim->data.store(data, std::memory_order_relaxed);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+} // namespace OthelloEngine
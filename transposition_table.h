@@ -0,0 +1,86 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+
+#include "bitboard.h"
+
+namespace OthelloEngine {
+
+// Zobrist hash of a position with `side` to move.
+uint64_t zobristHash(const Position& pos, Color side);
+
+// Hash change for `side` playing on `sq` with `flips`, including the side-to-move toggle.
+uint64_t zobristMoveDelta(Color side, int sq, uint64_t flips);
+
+// Hash change for a pass (side-to-move toggle only).
+uint64_t zobristPassDelta();
+
+// Hash shared by a position and its 7 mirror images (and by the colour-swapped position with the
+// other side to move): the Zobrist hash of canonicalize(mover's discs, opponent's discs) with the
+// mover as black. `sym` receives the symmetry that maps this board onto the canonical one, so a move
+// stored under the canonical key is transformSquare(move, sym) and reads back with untransformSquare.
+uint64_t canonicalHash(const Position& pos, Color side, int* sym = nullptr);
+
+enum class Bound : uint8_t { NONE = 0, UPPER = 1, LOWER = 2, EXACT = 3 };
+
+struct TTHit {
+    int score;
+    int depth;
+    int move;    // -1 if none stored
+    Bound bound;
+};
+
+// Probe/hit/store counters. Kept by each search thread, not by the shared table.
+struct TTStats {
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+    uint64_t stores = 0;
+
+    TTStats& operator+=(const TTStats& o) { probes += o.probes; hits += o.hits; stores += o.stores; return *this; }
+};
+
+// Fixed-size transposition table. Four 16-byte entries share one 64-byte bucket (one cache
+// line); a probe touches a single line. Replacement inside a bucket prefers, in order: the same
+// key, entries left over from an earlier search, then the shallowest entry.
+//
+// probe/store are lock-free and may be called from several search threads at once: each entry
+// stores key ^ data next to data, so a torn write fails the key check and reads as a miss.
+class TranspositionTable {
+public:
+    static constexpr size_t MAX_MEGABYTES = size_t(1) << 16;  // 64 GB
+
+    explicit TranspositionTable(size_t megabytes = 16) { resize(megabytes); }
+
+    // Reallocates to the largest power-of-two bucket count that fits in `megabytes` (clamped to
+    // [1, MAX_MEGABYTES]); clears contents. Not thread-safe: call between searches.
+    void resize(size_t megabytes);
+    void clear();
+    // Called once per root search so stale entries become preferred victims.
+    void newSearch() { generation = static_cast<uint8_t>(generation + 1); }
+
+    bool probe(uint64_t key, TTHit& out) const;
+    void store(uint64_t key, int score, int depth, int move, Bound bound);
+
+    size_t sizeBytes() const { return bucketCount * sizeof(Bucket); }
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> check;  // key ^ data
+        std::atomic<uint64_t> data;   // score:32 | move:8 | depth:8 | bound:8 | generation:8
+    };
+    struct alignas(64) Bucket {
+        Entry entries[4];
+    };
+
+    std::unique_ptr<Bucket[]> buckets;
+    size_t bucketCount = 0;
+    uint64_t mask = 0;
+    uint8_t generation = 0;
+};
+
+} // namespace OthelloEngine
+
+#endif